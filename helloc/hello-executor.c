@@ -0,0 +1,270 @@
+#define _GNU_SOURCE /* pthread_setaffinity_np */
+#include "hello-executor.h"
+
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "wasm-rt-impl.h"
+
+static _Thread_local hello_worker_t* t_current_worker;
+
+static void deque_init(hello_deque_t* deque) {
+  pthread_mutex_init(&deque->mutex, NULL);
+  deque->tasks = NULL;
+  deque->head = deque->count = deque->capacity = 0;
+}
+
+static void deque_destroy(hello_deque_t* deque) {
+  free(deque->tasks);
+  pthread_mutex_destroy(&deque->mutex);
+}
+
+static void deque_push(hello_deque_t* deque, hello_task_t* task) {
+  pthread_mutex_lock(&deque->mutex);
+  if (deque->count == deque->capacity) {
+    size_t capacity = deque->capacity ? deque->capacity * 2 : 64;
+    hello_task_t** tasks = malloc(capacity * sizeof(*tasks));
+    if (!tasks) {
+      perror("hello_executor_submit");
+      abort();
+    }
+    size_t i;
+    for (i = 0; i < deque->count; ++i)
+      tasks[i] = deque->tasks[(deque->head + i) % deque->capacity];
+    free(deque->tasks);
+    deque->tasks = tasks;
+    deque->head = 0;
+    deque->capacity = capacity;
+  }
+  deque->tasks[(deque->head + deque->count) % deque->capacity] = task;
+  __atomic_store_n(&deque->count, deque->count + 1, __ATOMIC_RELAXED);
+  pthread_mutex_unlock(&deque->mutex);
+}
+
+/* Newest task, for the owner: it is the most likely to still be in cache. */
+static hello_task_t* deque_pop(hello_deque_t* deque) {
+  hello_task_t* task = NULL;
+  pthread_mutex_lock(&deque->mutex);
+  if (deque->count > 0) {
+    __atomic_store_n(&deque->count, deque->count - 1, __ATOMIC_RELAXED);
+    task = deque->tasks[(deque->head + deque->count) % deque->capacity];
+  }
+  pthread_mutex_unlock(&deque->mutex);
+  return task;
+}
+
+/* Oldest task, for thieves. Empty deques are skipped without taking their
+ * lock; that is why `count` is only ever changed with atomic stores. */
+static hello_task_t* deque_steal(hello_deque_t* deque) {
+  hello_task_t* task = NULL;
+  if (__atomic_load_n(&deque->count, __ATOMIC_RELAXED) == 0)
+    return NULL;
+  pthread_mutex_lock(&deque->mutex);
+  if (deque->count > 0) {
+    task = deque->tasks[deque->head];
+    deque->head = (deque->head + 1) % deque->capacity;
+    __atomic_store_n(&deque->count, deque->count - 1, __ATOMIC_RELAXED);
+  }
+  pthread_mutex_unlock(&deque->mutex);
+  return task;
+}
+
+static hello_task_t* take_task(hello_worker_t* worker) {
+  hello_executor_t* executor = worker->executor;
+  hello_task_t* task = deque_pop(&worker->deque);
+  /* Steal on the worker's own node first. A task stolen from another node
+   * still runs on this worker's instance, so its memory stays local. */
+  int pass;
+  for (pass = 0; pass < 2 && !task; ++pass) {
+    size_t i;
+    for (i = 1; !task && i < executor->worker_count; ++i) {
+      hello_worker_t* victim =
+          &executor->workers[(worker->index + i) % executor->worker_count];
+      if ((victim->node == worker->node) == (pass == 0))
+        task = deque_steal(&victim->deque);
+    }
+  }
+  if (task)
+    __atomic_sub_fetch(&executor->queued, 1, __ATOMIC_SEQ_CST);
+  return task;
+}
+
+static void run_task(hello_worker_t* worker, hello_task_t* task) {
+  hello_executor_t* executor = worker->executor;
+  wasm_rt_impl_try_scope_t scope;
+  wasm_rt_impl_try_begin(&scope);
+  wasm_rt_trap_t trap = wasm_rt_impl_try();
+  if (trap == WASM_RT_TRAP_NONE) {
+    hello_host_set_deadline(
+        worker->host, __atomic_load_n(&executor->task_deadline, __ATOMIC_RELAXED));
+    task->run(task, worker->host);
+    hello_host_set_deadline(worker->host, 0);
+    hello_host_arena_reset(worker->host);
+  }
+  wasm_rt_impl_try_end(&scope);
+  if (trap != WASM_RT_TRAP_NONE) {
+    /* The instance may be in any state after a trap; start over. */
+    hello_pool_release(&executor->pool, worker->host);
+    worker->host = hello_pool_acquire_on_node(&executor->pool, worker->node);
+  }
+  if (task->done)
+    task->done(task, trap);
+
+  if (__atomic_sub_fetch(&executor->outstanding, 1, __ATOMIC_SEQ_CST) == 0) {
+    pthread_mutex_lock(&executor->mutex);
+    pthread_cond_broadcast(&executor->all_done);
+    pthread_mutex_unlock(&executor->mutex);
+  }
+}
+
+/* Restrict the calling thread to the CPUs of `node`, as listed in sysfs
+ * ("0-3,8-11"). The scheduler may still move it between those CPUs. */
+static void pin_to_node(int node) {
+  char path[64];
+  snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist",
+           node);
+  FILE* file = fopen(path, "r");
+  if (!file)
+    return;
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  int first, last;
+  while (fscanf(file, "%d", &first) == 1) {
+    last = first;
+    if (fscanf(file, "-%d", &last) < 0)
+      last = first;
+    for (; first <= last && first < CPU_SETSIZE; ++first)
+      CPU_SET(first, &cpus);
+    if (fgetc(file) != ',')
+      break;
+  }
+  fclose(file);
+  if (CPU_COUNT(&cpus) > 0)
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+}
+
+static void* worker_main(void* arg) {
+  hello_worker_t* worker = arg;
+  hello_executor_t* executor = worker->executor;
+  t_current_worker = worker;
+  /* Pin before the first instance is created, so its memory is placed on
+   * the node the worker will keep running on. */
+  if (executor->pool.node_count > 1)
+    pin_to_node(worker->node);
+  worker->host = hello_pool_acquire_on_node(&executor->pool, worker->node);
+
+  for (;;) {
+    hello_task_t* task = take_task(worker);
+    if (task) {
+      run_task(worker, task);
+      continue;
+    }
+
+    /* Announce the sleeper before re-checking `queued`; submitters bump
+     * `queued` before checking `sleepers`, so one side sees the other. */
+    pthread_mutex_lock(&executor->mutex);
+    __atomic_add_fetch(&executor->sleepers, 1, __ATOMIC_SEQ_CST);
+    while (__atomic_load_n(&executor->queued, __ATOMIC_SEQ_CST) == 0 &&
+           !executor->stopping)
+      pthread_cond_wait(&executor->work_available, &executor->mutex);
+    __atomic_sub_fetch(&executor->sleepers, 1, __ATOMIC_SEQ_CST);
+    int stop = executor->stopping &&
+               __atomic_load_n(&executor->queued, __ATOMIC_SEQ_CST) == 0;
+    pthread_mutex_unlock(&executor->mutex);
+    if (stop)
+      break;
+  }
+
+  hello_pool_release(&executor->pool, worker->host);
+  return NULL;
+}
+
+void hello_executor_init(hello_executor_t* executor, size_t worker_count) {
+  if (worker_count == 0) {
+    long ncpu = sysconf(_SC_NPROCESSORS_ONLN);
+    worker_count = ncpu > 0 ? (size_t)ncpu : 1;
+  }
+  hello_pool_init(&executor->pool);
+  executor->worker_count = worker_count;
+  executor->next_worker = 0;
+  executor->queued = executor->outstanding = executor->sleepers = 0;
+  executor->task_deadline = 0;
+  executor->stopping = 0;
+  pthread_mutex_init(&executor->mutex, NULL);
+  pthread_cond_init(&executor->work_available, NULL);
+  pthread_cond_init(&executor->all_done, NULL);
+
+  executor->workers = calloc(worker_count, sizeof(hello_worker_t));
+  if (!executor->workers) {
+    perror("hello_executor_init");
+    abort();
+  }
+  size_t i;
+  for (i = 0; i < worker_count; ++i) {
+    hello_worker_t* worker = &executor->workers[i];
+    worker->executor = executor;
+    worker->index = i;
+    worker->node = (int)(i % (size_t)executor->pool.node_count);
+    deque_init(&worker->deque);
+  }
+  for (i = 0; i < worker_count; ++i) {
+    if (pthread_create(&executor->workers[i].thread, NULL, worker_main,
+                       &executor->workers[i]) != 0) {
+      perror("hello_executor_init");
+      abort();
+    }
+  }
+}
+
+void hello_executor_destroy(hello_executor_t* executor) {
+  hello_executor_wait(executor);
+  pthread_mutex_lock(&executor->mutex);
+  executor->stopping = 1;
+  pthread_cond_broadcast(&executor->work_available);
+  pthread_mutex_unlock(&executor->mutex);
+
+  size_t i;
+  for (i = 0; i < executor->worker_count; ++i)
+    pthread_join(executor->workers[i].thread, NULL);
+  for (i = 0; i < executor->worker_count; ++i)
+    deque_destroy(&executor->workers[i].deque);
+  free(executor->workers);
+  pthread_cond_destroy(&executor->all_done);
+  pthread_cond_destroy(&executor->work_available);
+  pthread_mutex_destroy(&executor->mutex);
+  hello_pool_destroy(&executor->pool);
+}
+
+void hello_executor_submit(hello_executor_t* executor, hello_task_t* task) {
+  hello_worker_t* worker = t_current_worker;
+  if (!worker || worker->executor != executor) {
+    size_t next = __atomic_fetch_add(&executor->next_worker, 1,
+                                     __ATOMIC_RELAXED);
+    worker = &executor->workers[next % executor->worker_count];
+  }
+  /* Count first so a thief that finds the task never sees `queued` drop below
+   * zero; a worker woken a moment early just looks again. */
+  __atomic_add_fetch(&executor->outstanding, 1, __ATOMIC_SEQ_CST);
+  __atomic_add_fetch(&executor->queued, 1, __ATOMIC_SEQ_CST);
+  deque_push(&worker->deque, task);
+
+  if (__atomic_load_n(&executor->sleepers, __ATOMIC_SEQ_CST) > 0) {
+    pthread_mutex_lock(&executor->mutex);
+    pthread_cond_signal(&executor->work_available);
+    pthread_mutex_unlock(&executor->mutex);
+  }
+}
+
+void hello_executor_set_task_deadline(hello_executor_t* executor,
+                                      u64 epochs) {
+  __atomic_store_n(&executor->task_deadline, epochs, __ATOMIC_RELAXED);
+}
+
+void hello_executor_wait(hello_executor_t* executor) {
+  pthread_mutex_lock(&executor->mutex);
+  while (__atomic_load_n(&executor->outstanding, __ATOMIC_SEQ_CST) != 0)
+    pthread_cond_wait(&executor->all_done, &executor->mutex);
+  pthread_mutex_unlock(&executor->mutex);
+}
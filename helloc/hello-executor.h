@@ -0,0 +1,89 @@
+#ifndef HELLO_EXECUTOR_H_
+#define HELLO_EXECUTOR_H_
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <pthread.h>
+#include <stddef.h>
+
+#include "hello-pool.h"
+
+/* One unit of work for the executor, e.g. a single `Z_greetZ_ii` call. The
+ * caller owns the storage and must keep it alive until `done` runs. */
+typedef struct hello_task_t hello_task_t;
+struct hello_task_t {
+  /* Runs on a worker thread with the instance pinned to that worker. A trap
+   * unwinds out of `run`; the worker then replaces its instance. Each task is
+   * one request for `hello_host_arena_reset`: guest allocations do not
+   * outlive it. */
+  void (*run)(hello_task_t* task, hello_host_t* host);
+  /* Optional; called on the same worker after `run` returned or trapped. */
+  void (*done)(hello_task_t* task, wasm_rt_trap_t trap);
+};
+
+/* Pending tasks of one worker. The owner pushes and pops at the tail, other
+ * workers steal from the head. */
+typedef struct hello_deque_t {
+  pthread_mutex_t mutex;
+  hello_task_t** tasks;
+  size_t head, count, capacity;
+} hello_deque_t;
+
+struct hello_executor_t;
+
+typedef struct hello_worker_t {
+  struct hello_executor_t* executor;
+  pthread_t thread;
+  size_t index;
+  /* NUMA node the worker is pinned to; its instances live there too. */
+  int node;
+  hello_deque_t deque;
+  /* The instance every task on this worker runs on. */
+  hello_host_t* host;
+} hello_worker_t;
+
+/* N worker threads running tasks on their own instances of hello.wasm, with
+ * idle workers stealing queued tasks from busy ones. On a NUMA machine the
+ * workers are spread over the nodes and pinned to them, and prefer stealing
+ * from workers on their own node. */
+typedef struct hello_executor_t {
+  hello_pool_t pool;
+  hello_worker_t* workers;
+  size_t worker_count;
+  /* Round-robin target for tasks submitted from outside the workers. */
+  size_t next_worker;
+  /* Tasks queued but not yet taken, and submitted but not yet finished. */
+  size_t queued;
+  size_t outstanding;
+  size_t sleepers;
+  /* Epochs each task may run for; 0 for no limit. */
+  u64 task_deadline;
+  int stopping;
+  pthread_mutex_t mutex;
+  pthread_cond_t work_available;
+  pthread_cond_t all_done;
+} hello_executor_t;
+
+/* Start `worker_count` workers (one per online CPU if 0). `hello_host_init`
+ * must have been called. */
+extern void hello_executor_init(hello_executor_t* executor, size_t worker_count);
+/* Wait for all submitted tasks, then stop the workers. */
+extern void hello_executor_destroy(hello_executor_t* executor);
+
+/* Queue `task`. From a worker thread it goes to that worker's own deque, from
+ * anywhere else to the workers in turn. */
+extern void hello_executor_submit(hello_executor_t* executor, hello_task_t* task);
+/* Interrupt tasks that run for longer than `epochs` ticks of `wasm_rt_epoch`
+ * (see `hello_host_set_deadline`); they finish with WASM_RT_TRAP_INTERRUPT
+ * and the worker moves on to a fresh instance. 0, the default, disables it. */
+extern void hello_executor_set_task_deadline(hello_executor_t* executor,
+                                             u64 epochs);
+/* Block until every task submitted so far has finished. */
+extern void hello_executor_wait(hello_executor_t* executor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* HELLO_EXECUTOR_H_ */
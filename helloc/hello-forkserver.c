@@ -0,0 +1,61 @@
+#include "hello-forkserver.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "wasm-rt-impl.h"
+
+void hello_forkserver_init(hello_forkserver_t* server) {
+  hello_host_instantiate(&server->host);
+}
+
+void hello_forkserver_destroy(hello_forkserver_t* server) {
+  hello_host_free(&server->host);
+}
+
+pid_t hello_forkserver_spawn(hello_forkserver_t* server,
+                             hello_forkserver_fn_t fn,
+                             void* arg) {
+  /* Otherwise output still buffered in the launcher is written again by every
+   * worker. */
+  hello_host_flush(&server->host);
+  fflush(NULL);
+  pid_t pid = fork();
+  if (pid < 0) {
+    perror("hello_forkserver_spawn");
+    abort();
+  }
+  if (pid > 0)
+    return pid;
+
+  /* The worker: report a trap as the exit status, and skip atexit handlers
+   * and stdio buffers that belong to the launcher. The launcher's io_uring
+   * is shared with the child after fork(), so the worker writes directly. */
+  hello_host_set_io_backend(HELLO_IO_WRITEV);
+  server->host.output_ring = NULL;
+  wasm_rt_impl_try_scope_t scope;
+  wasm_rt_impl_try_begin(&scope);
+  wasm_rt_trap_t trap = wasm_rt_impl_try();
+  if (trap == WASM_RT_TRAP_NONE)
+    fn(&server->host, arg);
+  wasm_rt_impl_try_end(&scope);
+  hello_host_flush(&server->host);
+  fflush(NULL);
+  _exit(trap);
+}
+
+int hello_forkserver_wait(pid_t pid) {
+  int status;
+  while (waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR) {
+      perror("hello_forkserver_wait");
+      return -1;
+    }
+  }
+  if (!WIFEXITED(status) || WEXITSTATUS(status) > WASM_RT_TRAP_INTERRUPT)
+    return -1;
+  return WEXITSTATUS(status);
+}
@@ -0,0 +1,42 @@
+#ifndef HELLO_FORKSERVER_H_
+#define HELLO_FORKSERVER_H_
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sys/types.h>
+
+#include "hello-host.h"
+
+/* Process-per-instance launcher. The module is instantiated and its
+ * constructors run once in the launcher; every worker is a fork() of it and
+ * starts from that instance through copy-on-write, without running
+ * `init_memory`, `init_table` or the constructors again.
+ *
+ * fork() only copies the calling thread, so create the fork server and spawn
+ * from a process that has not started any other threads. */
+typedef struct hello_forkserver_t {
+  hello_host_t host;
+} hello_forkserver_t;
+
+/* Called in the worker process with its copy of the instance. Return to end
+ * the worker; a trap ends it too. */
+typedef void (*hello_forkserver_fn_t)(hello_host_t* host, void* arg);
+
+/* `hello_host_init` must have been called. */
+extern void hello_forkserver_init(hello_forkserver_t* server);
+extern void hello_forkserver_destroy(hello_forkserver_t* server);
+
+/* Start a worker process running `fn(host, arg)`. Returns its pid. */
+extern pid_t hello_forkserver_spawn(hello_forkserver_t* server,
+                                    hello_forkserver_fn_t fn,
+                                    void* arg);
+/* Wait for worker `pid` to end. Returns the trap that ended it,
+ * WASM_RT_TRAP_NONE if `fn` returned, or -1 if it died some other way. */
+extern int hello_forkserver_wait(pid_t pid);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* HELLO_FORKSERVER_H_ */
@@ -0,0 +1,632 @@
+#include "hello-host.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#endif
+
+#include "wasm-rt-impl.h"
+
+/* WASI errno values returned by the wasi_unstable imports. */
+#define WASI_ESUCCESS 0
+#define WASI_EBADF 8
+#define WASI_EFAULT 21
+#define WASI_EINVAL 28
+#define WASI_EIO 29
+
+#define HOST_IOV_MAX 64
+
+static u64 g_committed_bytes;
+
+static hello_host_t* host_of(hello_instance_t* instance) {
+  return (hello_host_t*)instance->host;
+}
+
+/* Account for `memory` having changed size from `old_size`. */
+static void host_update_committed(hello_host_t* host, u32 old_size) {
+  u32 size = host->memory.size;
+  if (size > old_size)
+    __atomic_add_fetch(&g_committed_bytes, size - old_size, __ATOMIC_RELAXED);
+  else if (size < old_size)
+    __atomic_sub_fetch(&g_committed_bytes, old_size - size, __ATOMIC_RELAXED);
+  if (host->memory.pages > host->peak_pages)
+    host->peak_pages = host->memory.pages;
+}
+
+void* hello_host_ptr(hello_host_t* host, u32 addr, u32 len) {
+  if ((u64)addr + len > host->memory.size)
+    return NULL;
+  return &host->memory.data[addr];
+}
+
+/* For the words the host keeps in low linear memory, which is always there. */
+static u32 host_load_u32(hello_host_t* host, u32 addr) {
+  u32 value;
+  memcpy(&value, &host->memory.data[addr], sizeof(value));
+  return value;
+}
+
+#if HELLO_ARENA_MALLOC
+static void host_store_u32(hello_host_t* host, u32 addr, u32 value) {
+  memcpy(&host->memory.data[addr], &value, sizeof(value));
+}
+#endif
+
+/* Write all of `iovs`, resuming after short writes. */
+static int write_fully(int fd, struct iovec* iovs, int iovcnt) {
+  while (iovcnt > 0) {
+    ssize_t written = writev(fd, iovs, iovcnt);
+    if (written < 0) {
+      if (errno == EINTR)
+        continue;
+      return -1;
+    }
+    while (iovcnt > 0 && (size_t)written >= iovs->iov_len) {
+      written -= (ssize_t)iovs->iov_len;
+      ++iovs;
+      --iovcnt;
+    }
+    if (iovcnt > 0) {
+      iovs->iov_base = (u8*)iovs->iov_base + written;
+      iovs->iov_len -= (size_t)written;
+    }
+  }
+  return 0;
+}
+
+static hello_io_backend_t g_io_backend = HELLO_IO_WRITEV;
+
+int hello_host_set_io_backend(hello_io_backend_t backend) {
+  if (backend == HELLO_IO_URING && !hello_uring_available())
+    return -1;
+  g_io_backend = backend;
+  return 0;
+}
+
+hello_io_backend_t hello_host_io_backend(void) {
+  return g_io_backend;
+}
+
+/* The io_uring write of `output` has finished. A short or failed write is
+ * finished synchronously; the buffer is still untouched at this point. */
+static void host_output_complete(hello_uring_op_t* op, int result) {
+  hello_host_t* host =
+      (hello_host_t*)((u8*)op - offsetof(hello_host_t, output_op));
+  if (result >= 0 && (u32)result < host->output_iov.iov_len) {
+    host->output_iov.iov_base = (u8*)host->output_iov.iov_base + result;
+    host->output_iov.iov_len -= (size_t)result;
+    write_fully(STDOUT_FILENO, &host->output_iov, 1);
+  }
+}
+
+/* Wait until the buffer is no longer being written from. */
+static void host_wait_output(hello_host_t* host) {
+  if (host->output_ring)
+    hello_uring_wait(host->output_ring, &host->output_op);
+}
+
+/* Write the buffered stdout output, then `iovs[1..iovcnt)`, with one writev;
+ * `iovs[0]` is where the buffer goes. */
+static int host_flush_with(hello_host_t* host, struct iovec* iovs, int iovcnt) {
+  iovs[0].iov_base = host->output;
+  iovs[0].iov_len = host->output_len;
+  host->output_len = 0;
+  host->instance.export_return = NULL;
+  return write_fully(STDOUT_FILENO, iovs, iovcnt);
+}
+
+int hello_host_flush(hello_host_t* host) {
+  host_wait_output(host);
+  if (host->output_len == 0)
+    return 0;
+  if (g_io_backend == HELLO_IO_URING) {
+    hello_uring_t* ring = hello_uring_current();
+    host->output_iov.iov_base = host->output;
+    host->output_iov.iov_len = host->output_len;
+    host->output_op.complete = host_output_complete;
+    if (ring && hello_uring_writev(ring, &host->output_op, STDOUT_FILENO,
+                                   &host->output_iov, 1) == 0) {
+      host->output_ring = ring;
+      host->output_len = 0;
+      host->instance.export_return = NULL;
+      return 0;
+    }
+  }
+  struct iovec iov;
+  return host_flush_with(host, &iov, 1);
+}
+
+/* Flush and wait for the write to finish. */
+static int host_drain_output(hello_host_t* host) {
+  int result = hello_host_flush(host);
+  host_wait_output(host);
+  return result;
+}
+
+/* Only armed while output is buffered, so exports that print nothing do not
+ * pay for the call. A failed write is lost: the guest was told it succeeded. */
+static void host_export_return(hello_instance_t* instance) {
+  hello_host_flush(host_of(instance));
+}
+
+/* stdout is buffered per instance; stderr is written through, after any
+ * buffered stdout output so the two stay in order. */
+static u32 host_fd_write(hello_instance_t* instance,
+                         u32 fd,
+                         u32 iov,
+                         u32 iovcnt,
+                         u32 pnum) {
+  hello_host_t* host = host_of(instance);
+  /* iovs[0] is reserved for the output buffer. */
+  struct iovec iovs[HOST_IOV_MAX + 1];
+  if (fd != STDOUT_FILENO && fd != STDERR_FILENO)
+    return WASI_EBADF;
+  if (iovcnt > HOST_IOV_MAX)
+    return WASI_EINVAL;
+  const u8* guest_iovs = hello_host_ptr(host, iov, iovcnt * 8);
+  u32* num = hello_host_ptr(host, pnum, sizeof(u32));
+  if (!guest_iovs || !num)
+    return WASI_EFAULT;
+
+  u64 total = 0;
+  u32 i;
+  for (i = 0; i < iovcnt; ++i) {
+    u32 ptr, len;
+    memcpy(&ptr, guest_iovs + i * 8, sizeof(ptr));
+    memcpy(&len, guest_iovs + i * 8 + 4, sizeof(len));
+    iovs[i + 1].iov_base = hello_host_ptr(host, ptr, len);
+    iovs[i + 1].iov_len = len;
+    if (!iovs[i + 1].iov_base)
+      return WASI_EFAULT;
+    total += len;
+  }
+  if (total > UINT32_MAX)
+    return WASI_EINVAL;
+
+  if (fd == STDOUT_FILENO) {
+    host_wait_output(host);
+    if (host->output_len + total > HELLO_OUTPUT_BUFFER_SIZE) {
+      if (g_io_backend == HELLO_IO_WRITEV) {
+        if (host_flush_with(host, iovs, (int)iovcnt + 1) != 0)
+          return WASI_EIO;
+        *num = (u32)total;
+        return WASI_ESUCCESS;
+      }
+      /* The guest's buffers may change as soon as we return, so only the
+       * output buffer can be written asynchronously. */
+      if (host_drain_output(host) != 0)
+        return WASI_EIO;
+      if (total > HELLO_OUTPUT_BUFFER_SIZE) {
+        if (write_fully(STDOUT_FILENO, iovs + 1, (int)iovcnt) != 0)
+          return WASI_EIO;
+        *num = (u32)total;
+        return WASI_ESUCCESS;
+      }
+    }
+    for (i = 1; i <= iovcnt; ++i) {
+      memcpy(host->output + host->output_len, iovs[i].iov_base,
+             iovs[i].iov_len);
+      host->output_len += (u32)iovs[i].iov_len;
+    }
+    if (host->output_len != 0)
+      instance->export_return = host_export_return;
+  } else if (host_drain_output(host) != 0 ||
+             write_fully((int)fd, iovs + 1, (int)iovcnt) != 0) {
+    return WASI_EIO;
+  }
+  *num = (u32)total;
+  return WASI_ESUCCESS;
+}
+
+/* The guest's libc passes the address of a lock word: 0 free, 1 held, 2 held
+ * with sleepers. hello.js stubs these out; here they are a real mutex on the
+ * word: spin briefly, then sleep on a futex on the word itself. Uncontended,
+ * this is one atomic each way. The module only locks its open file list
+ * (f24/f25) and its shadow stack is not per thread, so this alone does not
+ * make guest code safe to run on several threads. */
+#define HOST_LOCK_SPINS 100
+
+static u32* host_lock_word(hello_instance_t* instance, u32 ptr) {
+  u32* word = hello_host_ptr(host_of(instance), ptr, sizeof(u32));
+  if (!word || ptr % sizeof(u32) != 0)
+    wasm_rt_trap(WASM_RT_TRAP_OOB);
+  return word;
+}
+
+static void host_lock(hello_instance_t* instance, u32 ptr) {
+  u32* word = host_lock_word(instance, ptr);
+  int i;
+  for (i = 0; i < HOST_LOCK_SPINS; ++i) {
+    u32 expected = 0;
+    if (__atomic_load_n(word, __ATOMIC_RELAXED) == 0 &&
+        __atomic_compare_exchange_n(word, &expected, 1, 0, __ATOMIC_ACQUIRE,
+                                    __ATOMIC_RELAXED))
+      return;
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+  }
+  /* Announce a sleeper; whoever unlocks next wakes one up. */
+  while (__atomic_exchange_n(word, 2, __ATOMIC_ACQUIRE) != 0) {
+#if defined(__linux__)
+    syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, 2, NULL, NULL, 0);
+#else
+    sched_yield();
+#endif
+  }
+}
+
+static void host_unlock(hello_instance_t* instance, u32 ptr) {
+  u32* word = host_lock_word(instance, ptr);
+  if (__atomic_exchange_n(word, 0, __ATOMIC_RELEASE) == 2) {
+#if defined(__linux__)
+    syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#endif
+  }
+}
+
+/* Failing here makes the guest's sbrk set ENOMEM and malloc return NULL. */
+static u32 host_resize_heap(hello_instance_t* instance, u32 requested_size) {
+  hello_host_t* host = host_of(instance);
+  wasm_rt_memory_t* memory = &host->memory;
+  u32 pages = (u32)(((u64)requested_size + 65535) / 65536);
+  if (pages <= memory->pages)
+    return 1;
+  if (pages > host->page_limit)
+    return 0;
+  u32 old_size = memory->size;
+  if (wasm_rt_grow_memory(memory, pages - memory->pages) == (u32)-1)
+    return 0;
+  host_update_committed(host, old_size);
+  return 1;
+}
+
+static u32 host_memcpy_big(hello_instance_t* instance,
+                           u32 dest,
+                           u32 src,
+                           u32 num) {
+  hello_host_t* host = host_of(instance);
+  void* d = hello_host_ptr(host, dest, num);
+  const void* s = hello_host_ptr(host, src, num);
+  if (!d || !s)
+    wasm_rt_trap(WASM_RT_TRAP_OOB);
+  memmove(d, s, num);
+  return dest;
+}
+
+static void host_set_temp_ret0(hello_instance_t* instance, u32 value) {
+  host_of(instance)->temp_ret0 = value;
+}
+
+#if HELLO_ARENA_MALLOC
+/* The guest heap as a bump arena: the sbrk break at DYNAMICTOP_PTR is its
+ * top, so trim, images and reset see it like the heap dlmalloc would have
+ * grown. Nothing is freed for real until `hello_host_arena_reset`, except the
+ * most recent allocation, which covers a result freed right after the call
+ * that made it. */
+static u32 host_malloc(hello_instance_t* instance, u32 size) {
+  hello_host_t* host = host_of(instance);
+  u32 addr = host_load_u32(host, HELLO_DYNAMICTOP_PTR);
+  /* Same alignment and minimum size as the dlmalloc it replaces. */
+  u64 end = (u64)addr + (size < 8 ? 8 : ((u64)size + 7) & ~(u64)7);
+  if (end > host->memory.size &&
+      (end > UINT32_MAX || !host_resize_heap(instance, (u32)end)))
+    return 0;
+  host_store_u32(host, HELLO_DYNAMICTOP_PTR, (u32)end);
+  host->arena_last = addr;
+  return addr;
+}
+
+static void host_free(hello_instance_t* instance, u32 ptr) {
+  hello_host_t* host = host_of(instance);
+  if (ptr != 0 && ptr == host->arena_last) {
+    host_store_u32(host, HELLO_DYNAMICTOP_PTR, ptr);
+    host->arena_last = 0;
+  }
+}
+#endif
+
+#if HELLO_STATIC_LINK
+/* The imports as the link-time symbols the module calls directly; the
+ * host_* functions above inline into them. */
+/* import: 'wasi_unstable' 'fd_write' */
+u32 Z_wasi_unstableZ_fd_writeZ_iiiii(hello_instance_t* instance,
+                                     u32 fd,
+                                     u32 iov,
+                                     u32 iovcnt,
+                                     u32 pnum) {
+  return host_fd_write(instance, fd, iov, iovcnt, pnum);
+}
+/* import: 'env' '__lock' */
+void Z_envZ___lockZ_vi(hello_instance_t* instance, u32 ptr) {
+  host_lock(instance, ptr);
+}
+/* import: 'env' '__unlock' */
+void Z_envZ___unlockZ_vi(hello_instance_t* instance, u32 ptr) {
+  host_unlock(instance, ptr);
+}
+/* import: 'env' 'emscripten_resize_heap' */
+u32 Z_envZ_emscripten_resize_heapZ_ii(hello_instance_t* instance,
+                                      u32 requested_size) {
+  return host_resize_heap(instance, requested_size);
+}
+/* import: 'env' 'emscripten_memcpy_big' */
+u32 Z_envZ_emscripten_memcpy_bigZ_iiii(hello_instance_t* instance,
+                                       u32 dest,
+                                       u32 src,
+                                       u32 num) {
+  return host_memcpy_big(instance, dest, src, num);
+}
+/* import: 'env' 'setTempRet0' */
+void Z_envZ_setTempRet0Z_vi(hello_instance_t* instance, u32 value) {
+  host_set_temp_ret0(instance, value);
+}
+#if HELLO_ARENA_MALLOC
+/* import: 'env' 'malloc' */
+u32 Z_envZ_mallocZ_ii(hello_instance_t* instance, u32 size) {
+  return host_malloc(instance, size);
+}
+/* import: 'env' 'free' */
+void Z_envZ_freeZ_vi(hello_instance_t* instance, u32 ptr) {
+  host_free(instance, ptr);
+}
+#endif
+#else
+/* import: 'wasi_unstable' 'fd_write' */
+u32 (*Z_wasi_unstableZ_fd_writeZ_iiiii)(hello_instance_t*, u32, u32, u32, u32) =
+    host_fd_write;
+/* import: 'env' '__lock' */
+void (*Z_envZ___lockZ_vi)(hello_instance_t*, u32) = host_lock;
+/* import: 'env' '__unlock' */
+void (*Z_envZ___unlockZ_vi)(hello_instance_t*, u32) = host_unlock;
+/* import: 'env' 'emscripten_resize_heap' */
+u32 (*Z_envZ_emscripten_resize_heapZ_ii)(hello_instance_t*, u32) =
+    host_resize_heap;
+/* import: 'env' 'emscripten_memcpy_big' */
+u32 (*Z_envZ_emscripten_memcpy_bigZ_iiii)(hello_instance_t*, u32, u32, u32) =
+    host_memcpy_big;
+/* import: 'env' 'setTempRet0' */
+void (*Z_envZ_setTempRet0Z_vi)(hello_instance_t*, u32) = host_set_temp_ret0;
+#if HELLO_ARENA_MALLOC
+/* import: 'env' 'malloc' */
+u32 (*Z_envZ_mallocZ_ii)(hello_instance_t*, u32) = host_malloc;
+/* import: 'env' 'free' */
+void (*Z_envZ_freeZ_vi)(hello_instance_t*, u32) = host_free;
+#endif
+#endif
+
+void hello_host_init(void) {
+  init();
+}
+
+void hello_host_instantiate(hello_host_t* host) {
+  memset(host, 0, sizeof(*host));
+  wasm_rt_allocate_memory(&host->memory, HELLO_INITIAL_PAGES, HELLO_MAX_PAGES);
+  wasm_rt_allocate_table(&host->table, HELLO_TABLE_SIZE, HELLO_TABLE_SIZE);
+  host->page_limit = HELLO_MAX_PAGES;
+  host->numa_node = -1;
+  host_update_committed(host, 0);
+  host->instance.host = host;
+  instantiate(&host->instance, &host->memory, &host->table);
+
+#if !HELLO_PREINIT
+  u32 dynamic_base = HELLO_DYNAMIC_BASE;
+  memcpy(&host->memory.data[HELLO_DYNAMICTOP_PTR], &dynamic_base,
+         sizeof(dynamic_base));
+
+  /* Don't clobber a trap handler the caller may have armed. */
+  wasm_rt_impl_try_scope_t scope;
+  wasm_rt_impl_try_begin(&scope);
+  if (wasm_rt_impl_try() != 0) {
+    fprintf(stderr, "hello: trap in __wasm_call_ctors\n");
+    abort();
+  }
+  Z___wasm_call_ctorsZ_vv(&host->instance);
+  wasm_rt_impl_try_end(&scope);
+#endif
+  host->arena_mark = host_load_u32(host, HELLO_DYNAMICTOP_PTR);
+}
+
+void hello_host_free(hello_host_t* host) {
+  host_drain_output(host);
+  u32 old_size = host->memory.size;
+  wasm_rt_free_memory(&host->memory);
+  host_update_committed(host, old_size);
+  wasm_rt_free_table(&host->table);
+}
+
+void hello_image_create(hello_image_t* image, const hello_host_t* host) {
+  wasm_rt_snapshot_memory(&image->memory, &host->memory);
+  image->globals = host->instance.globals;
+  memcpy(image->table, host->table.data, sizeof(image->table));
+}
+
+void hello_image_free(hello_image_t* image) {
+  wasm_rt_free_memory_snapshot(&image->memory);
+}
+
+void hello_host_instantiate_from_image(hello_host_t* host,
+                                       const hello_image_t* image) {
+  memset(host, 0, sizeof(*host));
+  wasm_rt_allocate_memory_from_snapshot(&host->memory, &image->memory,
+                                        HELLO_MAX_PAGES);
+  wasm_rt_allocate_table(&host->table, HELLO_TABLE_SIZE, HELLO_TABLE_SIZE);
+  memcpy(host->table.data, image->table, sizeof(image->table));
+  host->page_limit = HELLO_MAX_PAGES;
+  host->numa_node = -1;
+  host_update_committed(host, 0);
+  host->instance.Z_envZ_memory = &host->memory;
+  host->instance.Z_envZ_table = &host->table;
+  host->instance.globals = image->globals;
+  host->instance.epoch_deadline = UINT64_MAX;
+  host->instance.host = host;
+  host->arena_mark = host_load_u32(host, HELLO_DYNAMICTOP_PTR);
+}
+
+void hello_host_reset(hello_host_t* host, const hello_image_t* image) {
+  host_drain_output(host);
+  u32 old_size = host->memory.size;
+  wasm_rt_reset_memory(&host->memory, &image->memory);
+  host->peak_pages = 0;
+  host_update_committed(host, old_size);
+  memcpy(host->table.data, image->table, sizeof(image->table));
+  host->instance.globals = image->globals;
+  host->instance.epoch_deadline = UINT64_MAX;
+  host->temp_ret0 = 0;
+  host->arena_mark = host_load_u32(host, HELLO_DYNAMICTOP_PTR);
+  host->arena_last = 0;
+}
+
+void hello_host_arena_reset(hello_host_t* host) {
+#if HELLO_ARENA_MALLOC
+  host_store_u32(host, HELLO_DYNAMICTOP_PTR, host->arena_mark);
+  host->arena_last = 0;
+#else
+  (void)host;
+#endif
+}
+
+void hello_host_set_page_limit(hello_host_t* host, u32 pages) {
+  host->page_limit = pages < HELLO_MAX_PAGES ? pages : HELLO_MAX_PAGES;
+}
+
+void hello_host_memory_stats(const hello_host_t* host,
+                             hello_memory_stats_t* stats) {
+  stats->pages = host->memory.pages;
+  stats->peak_pages = host->peak_pages;
+  stats->page_limit = host->page_limit;
+  stats->committed_bytes = host->memory.size;
+}
+
+u64 hello_host_total_committed_bytes(void) {
+  return __atomic_load_n(&g_committed_bytes, __ATOMIC_RELAXED);
+}
+
+void hello_host_set_deadline(hello_host_t* host, u64 epochs) {
+  u64 epoch = __atomic_load_n(&wasm_rt_epoch, __ATOMIC_RELAXED);
+  host->instance.epoch_deadline =
+      epochs == 0 || epochs > UINT64_MAX - epoch ? UINT64_MAX : epoch + epochs;
+}
+
+static pthread_t g_epoch_thread;
+static int g_epoch_thread_running;
+static int g_epoch_thread_stop;
+static useconds_t g_epoch_interval_us;
+
+static void* epoch_thread_main(void* arg) {
+  (void)arg;
+  while (!__atomic_load_n(&g_epoch_thread_stop, __ATOMIC_RELAXED)) {
+    usleep(g_epoch_interval_us);
+    wasm_rt_increment_epoch();
+  }
+  return NULL;
+}
+
+void hello_host_start_epoch_timer(unsigned interval_us) {
+  if (g_epoch_thread_running)
+    return;
+  g_epoch_interval_us = interval_us;
+  __atomic_store_n(&g_epoch_thread_stop, 0, __ATOMIC_RELAXED);
+  if (pthread_create(&g_epoch_thread, NULL, epoch_thread_main, NULL) != 0) {
+    perror("hello_host_start_epoch_timer");
+    abort();
+  }
+  g_epoch_thread_running = 1;
+}
+
+void hello_host_stop_epoch_timer(void) {
+  if (!g_epoch_thread_running)
+    return;
+  __atomic_store_n(&g_epoch_thread_stop, 1, __ATOMIC_RELAXED);
+  pthread_join(g_epoch_thread, NULL);
+  g_epoch_thread_running = 0;
+}
+
+int hello_host_bind_to_node(hello_host_t* host, int node) {
+  if (wasm_rt_bind_memory_to_node(&host->memory, node) != 0)
+    return -1;
+  host->numa_node = node;
+  return 0;
+}
+
+int hello_numa_node_count(void) {
+  static int node_count;
+  int count = __atomic_load_n(&node_count, __ATOMIC_RELAXED);
+  if (count != 0)
+    return count;
+
+  /* A cpulist-style range like "0-1" or "0,2"; the last number is the highest
+   * online node. */
+  count = 1;
+  FILE* file = fopen("/sys/devices/system/node/online", "r");
+  if (file) {
+    int first, last;
+    while (fscanf(file, "%d", &first) == 1) {
+      last = first;
+      if (fscanf(file, "-%d", &last) < 0)
+        break;
+      if (last + 1 > count)
+        count = last + 1;
+      if (fgetc(file) != ',')
+        break;
+    }
+    fclose(file);
+  }
+  __atomic_store_n(&node_count, count, __ATOMIC_RELAXED);
+  return count;
+}
+
+int hello_numa_current_node(void) {
+#if defined(SYS_getcpu)
+  unsigned cpu, node;
+  if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0)
+    return (int)node;
+#endif
+  return 0;
+}
+
+u32 hello_host_trim(hello_host_t* host) {
+  /* The stack grows down from the initial g0 towards the sbrk top pointer,
+   * which is the last word of static data. */
+  u32 stack_low = HELLO_DYNAMICTOP_PTR + sizeof(u32);
+  u32 stack_pointer = host->instance.globals.g0;
+  /* The arena's top is the sbrk top itself. dlmalloc never shrinks the heap,
+   * so a large free leaves a big top chunk below the sbrk top; everything
+   * past its header is unused. */
+  u32 heap_top = host_load_u32(host, HELLO_DYNAMICTOP_PTR);
+#if !HELLO_ARENA_MALLOC
+  u32 top_chunk = host_load_u32(host, HELLO_MALLOC_TOP);
+  u32 top_size = host_load_u32(host, HELLO_MALLOC_TOPSIZE);
+  if (top_chunk >= HELLO_DYNAMIC_BASE && top_chunk < heap_top &&
+      (u64)top_chunk + top_size <= heap_top)
+    heap_top = top_chunk + 16;
+#endif
+
+  u32 released = 0;
+  if (stack_pointer > stack_low)
+    released += wasm_rt_discard_memory(&host->memory, stack_low,
+                                       stack_pointer - stack_low);
+  if (heap_top < host->memory.size)
+    released += wasm_rt_discard_memory(&host->memory, heap_top,
+                                       host->memory.size - heap_top);
+  return released;
+}
+
+u32 hello_host_strdup(hello_host_t* host, const char* str) {
+  u32 len = (u32)strlen(str) + 1;
+  u32 addr = Z_mallocZ_ii(&host->instance, len);
+  if (addr == 0)
+    return 0;
+  memcpy(hello_host_ptr(host, addr, len), str, len);
+  return addr;
+}
@@ -0,0 +1,183 @@
+#ifndef HELLO_HOST_H_
+#define HELLO_HOST_H_
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "hello-unwasm.h"
+#include "hello-uring.h"
+
+/* Layout baked into hello.wasm by emscripten (see STACK_BASE, DYNAMIC_BASE
+ * and DYNAMICTOP_PTR in the JS glue). The native host has to recreate what
+ * hello.js does before the first export is called. */
+#define HELLO_INITIAL_PAGES 256u   /* INITIAL_TOTAL_MEMORY / WASM_PAGE_SIZE */
+/* hello.js is built without ALLOW_MEMORY_GROWTH, so the heap cannot grow past
+ * the initial 16MiB. A native embedder may allow more; the guest's sbrk asks
+ * for it through emscripten_resize_heap. A module built with
+ * HELLO_FIXED_MEMORY only runs on the memory hello.js creates. */
+#if HELLO_FIXED_MEMORY
+#if HELLO_INITIAL_PAGES != HELLO_FIXED_MEMORY_PAGES
+#error "HELLO_FIXED_MEMORY_PAGES does not match hello.js"
+#endif
+#undef HELLO_MAX_PAGES
+#define HELLO_MAX_PAGES HELLO_FIXED_MEMORY_PAGES
+#elif !defined(HELLO_MAX_PAGES)
+#define HELLO_MAX_PAGES 256u
+#endif
+#define HELLO_TABLE_SIZE 6u
+#define HELLO_DYNAMICTOP_PTR 3616u
+#define HELLO_DYNAMIC_BASE 5246496u
+/* dlmalloc's global malloc_state (_gm_), at the address malloc() uses for it;
+ * its top chunk is the free space at the end of the heap. */
+#define HELLO_MALLOC_STATE 3112u
+#define HELLO_MALLOC_TOPSIZE (HELLO_MALLOC_STATE + 12u)
+#define HELLO_MALLOC_TOP (HELLO_MALLOC_STATE + 24u)
+
+/* Guest writes to stdout are gathered per instance and written with a single
+ * writev when the export returns, when this much is pending, or on
+ * `hello_host_flush`. */
+#define HELLO_OUTPUT_BUFFER_SIZE 4096u
+
+/* One instance of hello.wasm together with the memory and table it imports
+ * and the per-instance state of the native 'env'/'wasi_unstable' imports. */
+typedef struct hello_host_t {
+  hello_instance_t instance;
+  wasm_rt_memory_t memory;
+  wasm_rt_table_t table;
+  u32 temp_ret0;
+  /* Growth beyond this many pages fails; see `hello_host_set_page_limit`. */
+  u32 page_limit;
+  u32 peak_pages;
+  /* NUMA node the memory was placed on, or -1. */
+  int numa_node;
+  /* What the guest wrote to stdout and has not been flushed yet. */
+  u32 output_len;
+  u8 output[HELLO_OUTPUT_BUFFER_SIZE];
+  /* With the io_uring backend: the last write of `output`, on the ring of the
+   * thread that flushed it (NULL before the first one). */
+  hello_uring_t* output_ring;
+  hello_uring_op_t output_op;
+  struct iovec output_iov;
+  /* With HELLO_ARENA_MALLOC: the heap top `hello_host_arena_reset` returns
+   * to, and the last allocation, which free can still take back. */
+  u32 arena_mark;
+  u32 arena_last;
+} hello_host_t;
+
+/* Memory accounting of one instance. */
+typedef struct hello_memory_stats_t {
+  u32 pages;
+  /* Largest `pages` since instantiation or the last reset. */
+  u32 peak_pages;
+  u32 page_limit;
+  /* Linear memory backed by accessible pages (not necessarily resident). */
+  u64 committed_bytes;
+} hello_memory_stats_t;
+
+/* Everything `hello_host_instantiate` produces (memory contents after the data
+ * segments and constructors, globals, table elements), frozen so further
+ * instances can be created from it without re-running any of that. */
+typedef struct hello_image_t {
+  wasm_rt_memory_snapshot_t memory;
+  hello_globals_t globals;
+  wasm_rt_elem_t table[HELLO_TABLE_SIZE];
+} hello_image_t;
+
+/* Process-wide setup. Call once before the first `hello_host_instantiate`. */
+extern void hello_host_init(void);
+
+/* Allocate the memory and table of `host`, instantiate the module into them
+ * and run its constructors. With HELLO_PREINIT the constructors have already
+ * run at build time and their result is baked into the module. Different
+ * instances may be used from different threads concurrently. */
+extern void hello_host_instantiate(hello_host_t* host);
+extern void hello_host_free(hello_host_t* host);
+
+/* Freeze the current state of `host` into `image`. */
+extern void hello_image_create(hello_image_t* image, const hello_host_t* host);
+extern void hello_image_free(hello_image_t* image);
+
+/* Like `hello_host_instantiate`, but start from `image`. The memory maps the
+ * image copy-on-write where the platform allows it. */
+extern void hello_host_instantiate_from_image(hello_host_t* host,
+                                              const hello_image_t* image);
+/* Return an instance created from `image` to the state captured in it. Only
+ * the pages dirtied since the last reset are thrown away. */
+extern void hello_host_reset(hello_host_t* host, const hello_image_t* image);
+
+/* How buffered guest output reaches the file descriptor. */
+typedef enum {
+  HELLO_IO_WRITEV,
+  /* Flushes are queued on the io_uring of the flushing thread and complete
+   * asynchronously; see hello-uring.h. */
+  HELLO_IO_URING,
+} hello_io_backend_t;
+
+/* Select the backend for all instances; switch only while no instance has
+ * output in flight. Returns -1 (keeping the current one) if the kernel lacks
+ * io_uring. */
+extern int hello_host_set_io_backend(hello_io_backend_t backend);
+extern hello_io_backend_t hello_host_io_backend(void);
+
+/* Write out the stdout output `host` has buffered, e.g. after an export
+ * trapped. Reset and free flush too and wait for the write to finish.
+ * Returns 0, or -1 if the write failed; with io_uring the write is only
+ * started, and a late failure is dropped. */
+extern int hello_host_flush(hello_host_t* host);
+
+/* Release the physical pages of `host` that hold no live data between export
+ * calls: the stack below the stack pointer, and the heap from the start of
+ * malloc's free top chunk (or the arena's top) upwards.
+ * Call it while the instance is idle. Returns the number of bytes released. */
+extern u32 hello_host_trim(hello_host_t* host);
+
+/* Cap the linear memory of `host` at `pages` (never above HELLO_MAX_PAGES).
+ * When the guest heap would grow past it, emscripten_resize_heap fails and
+ * the guest's malloc returns NULL. A cap below the current size only stops
+ * further growth. The cap survives `hello_host_reset`. */
+extern void hello_host_set_page_limit(hello_host_t* host, u32 pages);
+extern void hello_host_memory_stats(const hello_host_t* host,
+                                    hello_memory_stats_t* stats);
+
+/* Linear memory committed by all live instances in the process, to shed load
+ * before the node runs out of memory. */
+extern u64 hello_host_total_committed_bytes(void);
+
+/* Let the next export calls on `host` run for `epochs` more ticks of
+ * `wasm_rt_epoch` before they trap with WASM_RT_TRAP_INTERRUPT; 0 removes the
+ * deadline. Only enforced when hello-unwasm.c is built with
+ * HELLO_EPOCH_INTERRUPT. Reset clears it. */
+extern void hello_host_set_deadline(hello_host_t* host, u64 epochs);
+/* Advance `wasm_rt_epoch` every `interval_us` microseconds from a background
+ * thread until stopped. Not thread-safe; call from the main thread. */
+extern void hello_host_start_epoch_timer(unsigned interval_us);
+extern void hello_host_stop_epoch_timer(void);
+
+/* Place the linear memory of `host` on NUMA node `node`, including pages it
+ * grows into later. Call it right after instantiating from an image, before
+ * the instance runs. Returns 0 on success, -1 if the memory stays unbound. */
+extern int hello_host_bind_to_node(hello_host_t* host, int node);
+
+/* Number of NUMA nodes (1 where there is no NUMA), and the node of the CPU
+ * the calling thread is running on. */
+extern int hello_numa_node_count(void);
+extern int hello_numa_current_node(void);
+
+/* End a request on an instance built with HELLO_ARENA_MALLOC: everything the
+ * guest malloc handed out since instantiation (or the last reset) is freed at
+ * once. The host must not hold on to any of those addresses. Without the
+ * arena, where dlmalloc owns the heap, it does nothing. */
+extern void hello_host_arena_reset(hello_host_t* host);
+
+/* Copy a NUL-terminated string into guest memory allocated with the guest
+ * malloc. Returns the guest address, or 0 if the guest is out of memory. */
+extern u32 hello_host_strdup(hello_host_t* host, const char* str);
+
+/* Host view of a guest address range; NULL if it is out of bounds. */
+extern void* hello_host_ptr(hello_host_t* host, u32 addr, u32 len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* HELLO_HOST_H_ */
@@ -0,0 +1,90 @@
+#include "hello-pool.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+void hello_pool_init(hello_pool_t* pool) {
+  pool->node_count = hello_numa_node_count();
+  pool->nodes = calloc((size_t)pool->node_count, sizeof(hello_pool_node_t));
+  if (!pool->nodes) {
+    perror("hello_pool_init");
+    abort();
+  }
+  int i;
+  for (i = 0; i < pool->node_count; ++i)
+    pthread_mutex_init(&pool->nodes[i].mutex, NULL);
+
+  hello_host_t template_host;
+  hello_host_instantiate(&template_host);
+  hello_image_create(&pool->image, &template_host);
+  hello_host_free(&template_host);
+}
+
+void hello_pool_destroy(hello_pool_t* pool) {
+  int i;
+  for (i = 0; i < pool->node_count; ++i) {
+    hello_pool_node_t* node = &pool->nodes[i];
+    size_t j;
+    for (j = 0; j < node->idle_count; ++j) {
+      hello_host_free(node->idle[j]);
+      free(node->idle[j]);
+    }
+    free(node->idle);
+    pthread_mutex_destroy(&node->mutex);
+  }
+  free(pool->nodes);
+  hello_image_free(&pool->image);
+}
+
+hello_host_t* hello_pool_acquire(hello_pool_t* pool) {
+  return hello_pool_acquire_on_node(
+      pool, pool->node_count > 1 ? hello_numa_current_node() : 0);
+}
+
+hello_host_t* hello_pool_acquire_on_node(hello_pool_t* pool, int node_index) {
+  if (node_index < 0 || node_index >= pool->node_count)
+    node_index = 0;
+  hello_pool_node_t* node = &pool->nodes[node_index];
+  hello_host_t* host = NULL;
+  pthread_mutex_lock(&node->mutex);
+  if (node->idle_count > 0)
+    host = node->idle[--node->idle_count];
+  pthread_mutex_unlock(&node->mutex);
+  if (host)
+    return host;
+
+  host = malloc(sizeof(hello_host_t));
+  if (!host) {
+    perror("hello_pool_acquire");
+    abort();
+  }
+  hello_host_instantiate_from_image(host, &pool->image);
+  /* Nothing to place on a single node. If binding fails the memory follows
+   * first touch, which is still the calling thread's node. */
+  if (pool->node_count > 1)
+    hello_host_bind_to_node(host, node_index);
+  host->numa_node = node_index;
+  return host;
+}
+
+void hello_pool_release(hello_pool_t* pool, hello_host_t* host) {
+  hello_host_reset(host, &pool->image);
+
+  int node_index = host->numa_node;
+  if (node_index < 0 || node_index >= pool->node_count)
+    node_index = 0;
+  hello_pool_node_t* node = &pool->nodes[node_index];
+  pthread_mutex_lock(&node->mutex);
+  if (node->idle_count == node->idle_capacity) {
+    size_t capacity = node->idle_capacity ? node->idle_capacity * 2 : 16;
+    hello_host_t** idle = realloc(node->idle, capacity * sizeof(*idle));
+    if (!idle) {
+      perror("hello_pool_release");
+      abort();
+    }
+    node->idle = idle;
+    node->idle_capacity = capacity;
+  }
+  node->idle[node->idle_count++] = host;
+  pthread_mutex_unlock(&node->mutex);
+}
@@ -0,0 +1,47 @@
+#ifndef HELLO_POOL_H_
+#define HELLO_POOL_H_
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <pthread.h>
+#include <stddef.h>
+
+#include "hello-host.h"
+
+/* Idle instances whose memory lives on one NUMA node. */
+typedef struct hello_pool_node_t {
+  pthread_mutex_t mutex;
+  hello_host_t** idle;
+  size_t idle_count, idle_capacity;
+} hello_pool_node_t;
+
+/* A set of interchangeable instances of hello.wasm for a request-per-instance
+ * model. The module is instantiated once when the pool is created and frozen
+ * into an image; every instance handed out starts from that image, and
+ * releasing an instance resets it back to the image for the next request.
+ *
+ * On a NUMA machine every instance is bound to the node it was created for
+ * and only ever handed out again for that node. */
+typedef struct hello_pool_t {
+  hello_image_t image;
+  hello_pool_node_t* nodes;
+  int node_count;
+} hello_pool_t;
+
+extern void hello_pool_init(hello_pool_t* pool);
+extern void hello_pool_destroy(hello_pool_t* pool);
+
+/* Take a ready instance out of the pool, creating one if none is idle. The
+ * instance's memory is on the NUMA node the caller is running on. */
+extern hello_host_t* hello_pool_acquire(hello_pool_t* pool);
+/* Like `hello_pool_acquire`, for a thread that will run on `node`. */
+extern hello_host_t* hello_pool_acquire_on_node(hello_pool_t* pool, int node);
+/* Reset `host` and make it available to the next acquire on its node. */
+extern void hello_pool_release(hello_pool_t* pool, hello_host_t* host);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* HELLO_POOL_H_ */
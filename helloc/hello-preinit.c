@@ -0,0 +1,96 @@
+/* Build-time pre-initialization of hello.wasm.
+ *
+ *   hello-preinit <output.inc>
+ *
+ * Instantiates the module the way hello-host.c does (data segments, table,
+ * DYNAMICTOP, __wasm_call_ctors) and writes the resulting memory and globals
+ * as C data. hello-unwasm.c compiled with -DHELLO_PREINIT includes that file
+ * and loads it in init_memory()/init_globals() instead of the original data
+ * segments, and hello_host_instantiate skips the work that is already baked
+ * in. The table is not dumped: MVP code cannot write to it, so init_table()
+ * already produces the post-constructor state. */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hello-host.h"
+
+/* Zero runs shorter than this are kept inside a segment rather than starting
+ * a new one. */
+#define PREINIT_MIN_GAP 32u
+
+static void write_segment(FILE* out, const u8* data, u32 start, u32 end) {
+  u32 i;
+  fprintf(out, "static const u8 preinit_segment_%u[] = {\n", start);
+  for (i = start; i < end; ++i)
+    fprintf(out, "0x%02x,%s", data[i], (i - start) % 16 == 15 ? "\n" : " ");
+  fprintf(out, "\n};\n\n");
+}
+
+int main(int argc, char** argv) {
+  if (argc != 2) {
+    fprintf(stderr, "usage: %s <output.inc>\n", argv[0]);
+    return 1;
+  }
+  FILE* out = fopen(argv[1], "w");
+  if (!out) {
+    perror(argv[1]);
+    return 1;
+  }
+
+  hello_host_t host;
+  hello_host_init();
+  hello_host_instantiate(&host);
+  const u8* data = host.memory.data;
+  u32 size = host.memory.size;
+
+  fprintf(out, "/* Generated by hello-preinit from hello.wasm; do not edit. */\n\n");
+  fprintf(out, "#define PREINIT_PAGES %uu\n", host.memory.pages);
+  fprintf(out, "#define PREINIT_G0 %uu\n", host.instance.globals.g0);
+  fprintf(out, "#define PREINIT_DATA_END %uu\n\n", host.instance.globals.__data_end);
+
+  /* Coalesce non-zero bytes into segments, then emit the table of them. */
+  u32 starts[256], ends[256];
+  u32 count = 0;
+  u32 i = 0;
+  while (i < size) {
+    if (data[i] == 0) {
+      ++i;
+      continue;
+    }
+    u32 start = i, end = i;
+    while (i < size) {
+      if (data[i] != 0) {
+        end = ++i;
+      } else if (i - end < PREINIT_MIN_GAP) {
+        ++i;
+      } else {
+        break;
+      }
+    }
+    if (count == sizeof(starts) / sizeof(starts[0])) {
+      fprintf(stderr, "hello-preinit: too many segments\n");
+      fclose(out);
+      remove(argv[1]);
+      return 1;
+    }
+    starts[count] = start;
+    ends[count] = end;
+    write_segment(out, data, start, end);
+    ++count;
+  }
+
+  fprintf(out, "static const wasm_rt_data_segment_t preinit_segments[] = {\n");
+  for (i = 0; i < count; ++i)
+    fprintf(out, "  {%uu, %uu, preinit_segment_%u},\n", starts[i],
+            ends[i] - starts[i], starts[i]);
+  fprintf(out, "};\n");
+
+  hello_host_free(&host);
+  if (fclose(out) != 0) {
+    perror(argv[1]);
+    remove(argv[1]);
+    return 1;
+  }
+  return 0;
+}
@@ -7,11 +7,59 @@
 
 #define TRAP(x) (wasm_rt_trap(WASM_RT_TRAP_##x), 0)
 
+#if WASM_RT_STACK_LIMIT
+#define FUNC_PROLOGUE                                                  \
+  if (UNLIKELY((uintptr_t)__builtin_frame_address(0) < wasm_rt_stack_limit)) \
+    wasm_rt_check_stack()
+
+#define FUNC_EPILOGUE
+#else
 #define FUNC_PROLOGUE                                            \
   if (++wasm_rt_call_stack_depth > WASM_RT_MAX_CALL_STACK_DEPTH) \
     TRAP(EXHAUSTION)
 
 #define FUNC_EPILOGUE --wasm_rt_call_stack_depth
+#endif
+
+/* Functions that call nothing else use a bounded, small frame. With a stack
+ * limit they need no check at all; otherwise they still count towards the
+ * depth so the limit means the same as before. */
+#if WASM_RT_STACK_LIMIT
+#define LEAF_PROLOGUE
+#define LEAF_EPILOGUE
+#else
+#define LEAF_PROLOGUE FUNC_PROLOGUE
+#define LEAF_EPILOGUE FUNC_EPILOGUE
+#endif
+
+/* Interruption points for HELLO_EPOCH_INTERRUPT: every loop header and the
+ * entry of every function that calls others, which together bound the work
+ * done between two checks. One relaxed load and compare against the
+ * instance's deadline; the embedder advances the epoch from another thread. */
+#if HELLO_EPOCH_INTERRUPT
+#define EPOCH_CHECK                                                 \
+  if (UNLIKELY(__atomic_load_n(&wasm_rt_epoch, __ATOMIC_RELAXED) >= \
+               instance->epoch_deadline))                           \
+  wasm_rt_epoch_deadline_reached(&instance->epoch_deadline)
+#else
+#define EPOCH_CHECK
+#endif
+
+/* The export wrappers. With HELLO_STATIC_LINK they are the exports
+ * themselves; otherwise they are static and `init_exports` stores them in
+ * the export function pointers. */
+#if HELLO_STATIC_LINK
+#define EXPORT_LINKAGE
+#define EXPORT_NAME(wrapper, name) WASM_RT_ADD_PREFIX(name)
+#else
+#define EXPORT_LINKAGE static
+#define EXPORT_NAME(wrapper, name) wrapper
+#endif
+
+/* Runs when an export returns to the embedder, but not when it traps. */
+#define EXPORT_EPILOGUE                  \
+  if (UNLIKELY(instance->export_return)) \
+  instance->export_return(instance)
 
 #define UNREACHABLE TRAP(UNREACHABLE)
 
@@ -21,8 +69,112 @@
        ? ((t)table.data[x].func)(__VA_ARGS__)        \
        : TRAP(CALL_INDIRECT))
 
+/* Call site whose type matches exactly one function `f` of the element
+ * segment, which init_table() stores at `slot`. If the entry still holds `f`
+ * the call is direct (and can be inlined); anything else takes the generic
+ * path, so the result is the same even if the embedder rewrites the table. */
+#if HELLO_IMMUTABLE_TABLE
+#define CALL_INDIRECT_DIRECT(table, t, ft, x, slot, f, ...) \
+  (LIKELY((x) == (slot)) ? f(__VA_ARGS__)                  \
+                         : CALL_INDIRECT(table, t, ft, x, __VA_ARGS__))
+#else
+#define CALL_INDIRECT_DIRECT(table, t, ft, x, slot, f, ...)             \
+  (LIKELY((x) < table.size &&                                           \
+          table.data[x].func == (wasm_rt_anyfunc_t)(&f) &&              \
+          table.data[x].func_type == func_types[ft])                    \
+       ? f(__VA_ARGS__)                                                 \
+       : CALL_INDIRECT(table, t, ft, x, __VA_ARGS__))
+#endif
+
+#if HELLO_FIXED_MEMORY
+/* The memory never grows or moves, so every function that accesses it loads
+ * the base once into `membase` (MEMORY_BASE) and the loads and stores below
+ * ignore their `mem`. It is deliberately not restrict: imports and nested
+ * guest calls write the same memory through pointers of their own. Without
+ * guard pages the address is masked into the memory instead of checked; an
+ * access starting near the end runs into the runtime's
+ * WASM_RT_MEMORY_PADDING, and out-of-bounds accesses wrap around instead of
+ * trapping. */
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER
+#define MEMADDR(a) (a)
+#else
+#if WASM_RT_MEMORY_PADDING < 8
+#error "HELLO_FIXED_MEMORY needs WASM_RT_MEMORY_PADDING >= 8"
+#endif
+#define MEMADDR(a) ((a) & (HELLO_FIXED_MEMORY_SIZE - 1))
+#endif
+
+#define MEMORY_BASE u8* const membase = instance->Z_envZ_memory->data
+
+#define DEFINE_LOAD(name, t1, t2, t3)                  \
+  static inline t3 name##_fixed(u8* base, u64 addr) {  \
+    t1 result;                                         \
+    memcpy(&result, &base[MEMADDR(addr)], sizeof(t1)); \
+    return (t3)(t2)result;                             \
+  }
+
+#define DEFINE_STORE(name, t1, t2)                                \
+  static inline void name##_fixed(u8* base, u64 addr, t2 value) { \
+    t1 wrapped = (t1)value;                                       \
+    memcpy(&base[MEMADDR(addr)], &wrapped, sizeof(t1));           \
+  }
+
+DEFINE_LOAD(i32_load, u32, u32, u32);
+DEFINE_LOAD(i64_load, u64, u64, u64);
+DEFINE_LOAD(f32_load, f32, f32, f32);
+DEFINE_LOAD(f64_load, f64, f64, f64);
+DEFINE_LOAD(i32_load8_s, s8, s32, u32);
+DEFINE_LOAD(i64_load8_s, s8, s64, u64);
+DEFINE_LOAD(i32_load8_u, u8, u32, u32);
+DEFINE_LOAD(i64_load8_u, u8, u64, u64);
+DEFINE_LOAD(i32_load16_s, s16, s32, u32);
+DEFINE_LOAD(i64_load16_s, s16, s64, u64);
+DEFINE_LOAD(i32_load16_u, u16, u32, u32);
+DEFINE_LOAD(i64_load16_u, u16, u64, u64);
+DEFINE_LOAD(i64_load32_s, s32, s64, u64);
+DEFINE_LOAD(i64_load32_u, u32, u64, u64);
+DEFINE_STORE(i32_store, u32, u32);
+DEFINE_STORE(i64_store, u64, u64);
+DEFINE_STORE(f32_store, f32, f32);
+DEFINE_STORE(f64_store, f64, f64);
+DEFINE_STORE(i32_store8, u8, u32);
+DEFINE_STORE(i32_store16, u16, u32);
+DEFINE_STORE(i64_store8, u8, u64);
+DEFINE_STORE(i64_store16, u16, u64);
+DEFINE_STORE(i64_store32, u32, u64);
+
+#define i32_load(mem, ...) i32_load_fixed(membase, __VA_ARGS__)
+#define i64_load(mem, ...) i64_load_fixed(membase, __VA_ARGS__)
+#define f32_load(mem, ...) f32_load_fixed(membase, __VA_ARGS__)
+#define f64_load(mem, ...) f64_load_fixed(membase, __VA_ARGS__)
+#define i32_load8_s(mem, ...) i32_load8_s_fixed(membase, __VA_ARGS__)
+#define i64_load8_s(mem, ...) i64_load8_s_fixed(membase, __VA_ARGS__)
+#define i32_load8_u(mem, ...) i32_load8_u_fixed(membase, __VA_ARGS__)
+#define i64_load8_u(mem, ...) i64_load8_u_fixed(membase, __VA_ARGS__)
+#define i32_load16_s(mem, ...) i32_load16_s_fixed(membase, __VA_ARGS__)
+#define i64_load16_s(mem, ...) i64_load16_s_fixed(membase, __VA_ARGS__)
+#define i32_load16_u(mem, ...) i32_load16_u_fixed(membase, __VA_ARGS__)
+#define i64_load16_u(mem, ...) i64_load16_u_fixed(membase, __VA_ARGS__)
+#define i64_load32_s(mem, ...) i64_load32_s_fixed(membase, __VA_ARGS__)
+#define i64_load32_u(mem, ...) i64_load32_u_fixed(membase, __VA_ARGS__)
+#define i32_store(mem, ...) i32_store_fixed(membase, __VA_ARGS__)
+#define i64_store(mem, ...) i64_store_fixed(membase, __VA_ARGS__)
+#define f32_store(mem, ...) f32_store_fixed(membase, __VA_ARGS__)
+#define f64_store(mem, ...) f64_store_fixed(membase, __VA_ARGS__)
+#define i32_store8(mem, ...) i32_store8_fixed(membase, __VA_ARGS__)
+#define i32_store16(mem, ...) i32_store16_fixed(membase, __VA_ARGS__)
+#define i64_store8(mem, ...) i64_store8_fixed(membase, __VA_ARGS__)
+#define i64_store16(mem, ...) i64_store16_fixed(membase, __VA_ARGS__)
+#define i64_store32(mem, ...) i64_store32_fixed(membase, __VA_ARGS__)
+#else
+#define MEMORY_BASE
+
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER
+#define MEMCHECK(mem, a, t)
+#else
 #define MEMCHECK(mem, a, t)  \
   if (UNLIKELY((a) + sizeof(t) > mem->size)) TRAP(OOB)
+#endif
 
 #define DEFINE_LOAD(name, t1, t2, t3)              \
   static inline t3 name(wasm_rt_memory_t* mem, u64 addr) {   \
@@ -62,6 +214,21 @@ DEFINE_STORE(i32_store16, u16, u32);
 DEFINE_STORE(i64_store8, u8, u64);
 DEFINE_STORE(i64_store16, u16, u64);
 DEFINE_STORE(i64_store32, u32, u64);
+#endif
+
+/* memory.copy and memory.fill. The whole range is checked up front, also with
+ * guard pages: the instructions trap before writing anything. */
+static inline void memory_copy(wasm_rt_memory_t* mem, u32 dest, u32 src, u32 n) {
+  if (UNLIKELY((u64)dest + n > mem->size || (u64)src + n > mem->size))
+    TRAP(OOB);
+  memmove(&mem->data[dest], &mem->data[src], n);
+}
+
+static inline void memory_fill(wasm_rt_memory_t* mem, u32 dest, u32 value, u32 n) {
+  if (UNLIKELY((u64)dest + n > mem->size))
+    TRAP(OOB);
+  memset(&mem->data[dest], (u8)value, n);
+}
 
 #define I32_CLZ(x) ((x) ? __builtin_clz(x) : 32)
 #define I64_CLZ(x) ((x) ? __builtin_clzll(x) : 64)
@@ -146,133 +313,140 @@ DEFINE_REINTERPRET(f64_reinterpret_i64, u64, f64)
 DEFINE_REINTERPRET(i64_reinterpret_f64, f64, u64)
 
 
-static u32 func_types[35];
-
-static void init_func_types(void) {
-  func_types[0] = wasm_rt_register_func_type(3, 1, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[1] = wasm_rt_register_func_type(6, 1, WASM_RT_I32, WASM_RT_F64, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[2] = wasm_rt_register_func_type(2, 0, WASM_RT_I32, WASM_RT_I32);
-  func_types[3] = wasm_rt_register_func_type(3, 1, WASM_RT_I32, WASM_RT_I64, WASM_RT_I32, WASM_RT_I64);
-  func_types[4] = wasm_rt_register_func_type(4, 1, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[5] = wasm_rt_register_func_type(1, 0, WASM_RT_I32);
-  func_types[6] = wasm_rt_register_func_type(0, 1, WASM_RT_I32);
-  func_types[7] = wasm_rt_register_func_type(1, 1, WASM_RT_I32, WASM_RT_I32);
-  func_types[8] = wasm_rt_register_func_type(0, 0);
-  func_types[9] = wasm_rt_register_func_type(2, 1, WASM_RT_F64, WASM_RT_F64, WASM_RT_F64);
-  func_types[10] = wasm_rt_register_func_type(2, 1, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[11] = wasm_rt_register_func_type(2, 1, WASM_RT_F64, WASM_RT_I32, WASM_RT_F64);
-  func_types[12] = wasm_rt_register_func_type(5, 1, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[13] = wasm_rt_register_func_type(7, 1, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[14] = wasm_rt_register_func_type(3, 0, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[15] = wasm_rt_register_func_type(4, 0, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[16] = wasm_rt_register_func_type(5, 0, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[17] = wasm_rt_register_func_type(2, 1, WASM_RT_I64, WASM_RT_I32, WASM_RT_I32);
-  func_types[18] = wasm_rt_register_func_type(3, 1, WASM_RT_I64, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[19] = wasm_rt_register_func_type(1, 1, WASM_RT_F64, WASM_RT_I64);
-  func_types[20] = wasm_rt_register_func_type(4, 0, WASM_RT_I32, WASM_RT_I64, WASM_RT_I64, WASM_RT_I32);
-  func_types[21] = wasm_rt_register_func_type(2, 1, WASM_RT_I64, WASM_RT_I64, WASM_RT_F64);
-  func_types[22] = wasm_rt_register_func_type(1, 1, WASM_RT_I32, WASM_RT_I32);
-  func_types[23] = wasm_rt_register_func_type(3, 1, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[24] = wasm_rt_register_func_type(3, 1, WASM_RT_I32, WASM_RT_I64, WASM_RT_I32, WASM_RT_I64);
-  func_types[25] = wasm_rt_register_func_type(6, 1, WASM_RT_I32, WASM_RT_F64, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[26] = wasm_rt_register_func_type(2, 0, WASM_RT_I32, WASM_RT_I32);
-  func_types[27] = wasm_rt_register_func_type(1, 0, WASM_RT_I32);
-  func_types[28] = wasm_rt_register_func_type(0, 1, WASM_RT_I32);
-  func_types[29] = wasm_rt_register_func_type(2, 1, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[30] = wasm_rt_register_func_type(4, 1, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[31] = wasm_rt_register_func_type(4, 1, WASM_RT_I32, WASM_RT_I32, WASM_RT_I64, WASM_RT_I32, WASM_RT_I64);
-  func_types[32] = wasm_rt_register_func_type(7, 1, WASM_RT_I32, WASM_RT_I32, WASM_RT_F64, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[33] = wasm_rt_register_func_type(3, 0, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-  func_types[34] = wasm_rt_register_func_type(5, 1, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
-}
+/* Canonical function type IDs (see WASM_RT_CANONICAL_FUNC_TYPE_BIT). */
+static const u32 func_types[35] = {
+  0x93000000u, /* 0: (i32, i32, i32) -> (i32) */
+  0x9600000cu, /* 1: (i32, f64, i32, i32, i32, i32) -> (i32) */
+  0x82000000u, /* 2: (i32, i32) -> () */
+  0x93000044u, /* 3: (i32, i64, i32) -> (i64) */
+  0x94000000u, /* 4: (i32, i32, i32, i32) -> (i32) */
+  0x81000000u, /* 5: (i32) -> () */
+  0x90000000u, /* 6: () -> (i32) */
+  0x91000000u, /* 7: (i32) -> (i32) */
+  0x80000000u, /* 8: () -> () */
+  0x9200003fu, /* 9: (f64, f64) -> (f64) */
+  0x92000000u, /* 10: (i32, i32) -> (i32) */
+  0x92000033u, /* 11: (f64, i32) -> (f64) */
+  0x95000000u, /* 12: (i32, i32, i32, i32, i32) -> (i32) */
+  0x97000000u, /* 13: (i32, i32, i32, i32, i32, i32, i32) -> (i32) */
+  0x83000000u, /* 14: (i32, i32, i32) -> () */
+  0x84000000u, /* 15: (i32, i32, i32, i32) -> () */
+  0x85000000u, /* 16: (i32, i32, i32, i32, i32) -> () */
+  0x92000001u, /* 17: (i64, i32) -> (i32) */
+  0x93000001u, /* 18: (i64, i32, i32) -> (i32) */
+  0x91000007u, /* 19: (f64) -> (i64) */
+  0x84000014u, /* 20: (i32, i64, i64, i32) -> () */
+  0x92000035u, /* 21: (i64, i64) -> (f64) */
+  0x91000000u, /* 22: (i32) -> (i32) */
+  0x93000000u, /* 23: (i32, i32, i32) -> (i32) */
+  0x93000044u, /* 24: (i32, i64, i32) -> (i64) */
+  0x9600000cu, /* 25: (i32, f64, i32, i32, i32, i32) -> (i32) */
+  0x82000000u, /* 26: (i32, i32) -> () */
+  0x81000000u, /* 27: (i32) -> () */
+  0x90000000u, /* 28: () -> (i32) */
+  0x92000000u, /* 29: (i32, i32) -> (i32) */
+  0x94000000u, /* 30: (i32, i32, i32, i32) -> (i32) */
+  0x94000110u, /* 31: (i32, i32, i64, i32) -> (i64) */
+  0x97000030u, /* 32: (i32, i32, f64, i32, i32, i32, i32) -> (i32) */
+  0x83000000u, /* 33: (i32, i32, i32) -> () */
+  0x95000000u, /* 34: (i32, i32, i32, i32, i32) -> (i32) */
+};
+
+static u32 f6(hello_instance_t*);
+static void __wasm_call_ctors(hello_instance_t*);
+static void sayHello(hello_instance_t*);
+static f64 add(hello_instance_t*, f64, f64);
+static u32 greet(hello_instance_t*, u32);
+static u32 f11(hello_instance_t*, u32, u32);
+static u32 f12(hello_instance_t*, u32, u32, u32);
+static u32 f13(hello_instance_t*, u32);
+static u64 f14(hello_instance_t*, u32, u64, u32);
+static u32 f15(hello_instance_t*, u32);
+static void f16(hello_instance_t*, u32);
+static u32 __errno_location(hello_instance_t*);
+static u32 f18(hello_instance_t*, u32);
+static u32 f19(hello_instance_t*);
+static u32 f20(hello_instance_t*, u32, u32, u32);
+static u32 f21(hello_instance_t*);
+static u32 f22(hello_instance_t*, u32, u32);
+static f64 f23(hello_instance_t*, f64, u32);
+static u32 f24(hello_instance_t*);
+static void f25(hello_instance_t*);
+static u32 f26(hello_instance_t*, u32);
+static u32 f27(hello_instance_t*, u32, u32, u32);
+static u32 f28(hello_instance_t*, u32, u32, u32, u32, u32);
+static u32 f29(hello_instance_t*, u32, u32, u32, u32, u32, u32, u32);
+static void f30(hello_instance_t*, u32, u32, u32);
+static u32 f31(hello_instance_t*, u32);
+static void f32_0(hello_instance_t*, u32, u32, u32, u32);
+static void f33(hello_instance_t*, u32, u32, u32, u32, u32);
+static u32 f34(hello_instance_t*, u64, u32);
+static u32 f35(hello_instance_t*, u64, u32, u32);
+static u32 f36(hello_instance_t*, u64, u32);
+static u32 f37(hello_instance_t*, u32, u32, u32);
+static u32 f38(hello_instance_t*, u32, f64, u32, u32, u32, u32);
+static void f39(hello_instance_t*, u32, u32);
+static u64 f40(hello_instance_t*, f64);
+static u32 f41(hello_instance_t*, u32, u32, u32);
+static u32 f42(hello_instance_t*, u32, u32);
+static u32 f43(hello_instance_t*, u32, u32);
+static u32 f44(hello_instance_t*, u32, u32);
+static u32 f45(hello_instance_t*, u32);
+static u32 f46(hello_instance_t*, u32);
+static void f47(hello_instance_t*, u32, u64, u64, u32);
+static void f48(hello_instance_t*, u32, u64, u64, u32);
+static f64 f49(hello_instance_t*, u64, u64);
+static u32 malloc(hello_instance_t*, u32);
+static void free(hello_instance_t*, u32);
+static u32 f52(hello_instance_t*, u32);
+static u32 f53(hello_instance_t*, u32, u32, u32);
+static u32 f54(hello_instance_t*, u32, u32, u32);
+static void setThrew(hello_instance_t*, u32, u32);
+static u32 fflush(hello_instance_t*, u32);
+static u32 f57(hello_instance_t*, u32);
+static u32 stackSave(hello_instance_t*);
+static u32 stackAlloc(hello_instance_t*, u32);
+static void stackRestore(hello_instance_t*, u32);
+static u32 __growWasmMemory(hello_instance_t*, u32);
+static u32 dynCall_ii(hello_instance_t*, u32, u32);
+static u32 dynCall_iiii(hello_instance_t*, u32, u32, u32, u32);
+static u64 f64_0(hello_instance_t*, u32, u32, u64, u32);
+static u32 dynCall_iidiiii(hello_instance_t*, u32, u32, f64, u32, u32, u32, u32);
+static void dynCall_vii(hello_instance_t*, u32, u32, u32);
+static u32 dynCall_jiji(hello_instance_t*, u32, u32, u32, u32, u32);
+
+#if HELLO_PREINIT
+/* Memory and globals as they are after __wasm_call_ctors, see hello-preinit.c. */
+#include "hello-preinit.inc"
 
-static u32 f6(void);
-static void __wasm_call_ctors(void);
-static void sayHello(void);
-static f64 add(f64, f64);
-static u32 greet(u32);
-static u32 f11(u32, u32);
-static u32 f12(u32, u32, u32);
-static u32 f13(u32);
-static u64 f14(u32, u64, u32);
-static u32 f15(u32);
-static void f16(u32);
-static u32 __errno_location(void);
-static u32 f18(u32);
-static u32 f19(void);
-static u32 f20(u32, u32, u32);
-static u32 f21(void);
-static u32 f22(u32, u32);
-static f64 f23(f64, u32);
-static u32 f24(void);
-static void f25(void);
-static u32 f26(u32);
-static u32 f27(u32, u32, u32);
-static u32 f28(u32, u32, u32, u32, u32);
-static u32 f29(u32, u32, u32, u32, u32, u32, u32);
-static void f30(u32, u32, u32);
-static u32 f31(u32);
-static void f32_0(u32, u32, u32, u32);
-static void f33(u32, u32, u32, u32, u32);
-static u32 f34(u64, u32);
-static u32 f35(u64, u32, u32);
-static u32 f36(u64, u32);
-static u32 f37(u32, u32, u32);
-static u32 f38(u32, f64, u32, u32, u32, u32);
-static void f39(u32, u32);
-static u64 f40(f64);
-static u32 f41(u32, u32, u32);
-static u32 f42(u32, u32);
-static u32 f43(u32, u32);
-static u32 f44(u32, u32);
-static u32 f45(u32);
-static u32 f46(u32);
-static void f47(u32, u64, u64, u32);
-static void f48(u32, u64, u64, u32);
-static f64 f49(u64, u64);
-static u32 malloc(u32);
-static void free(u32);
-static u32 f52(u32);
-static u32 f53(u32, u32, u32);
-static u32 f54(u32, u32, u32);
-static void setThrew(u32, u32);
-static u32 fflush(u32);
-static u32 f57(u32);
-static u32 stackSave(void);
-static u32 stackAlloc(u32);
-static void stackRestore(u32);
-static u32 __growWasmMemory(u32);
-static u32 dynCall_ii(u32, u32);
-static u32 dynCall_iiii(u32, u32, u32, u32);
-static u64 f64_0(u32, u32, u64, u32);
-static u32 dynCall_iidiiii(u32, u32, f64, u32, u32, u32, u32);
-static void dynCall_vii(u32, u32, u32);
-static u32 dynCall_jiji(u32, u32, u32, u32, u32);
-
-static u32 g0;
-static u32 __data_end;
-
-static void init_globals(void) {
-  g0 = 5246496u;
-  __data_end = 3616u;
+static void init_globals(hello_instance_t* instance) {
+  instance->globals.g0 = PREINIT_G0;
+  instance->globals.__data_end = PREINIT_DATA_END;
 }
+#else
+static void init_globals(hello_instance_t* instance) {
+  instance->globals.g0 = 5246496u;
+  instance->globals.__data_end = 3616u;
+}
+#endif
 
-static u32 f6(void) {
-  FUNC_PROLOGUE;
+static u32 f6(hello_instance_t* instance) {
+  LEAF_PROLOGUE;
   u32 i0;
   i0 = 3616u;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static void __wasm_call_ctors(void) {
-  FUNC_PROLOGUE;
-  FUNC_EPILOGUE;
+static void __wasm_call_ctors(hello_instance_t* instance) {
+  LEAF_PROLOGUE;
+  LEAF_EPILOGUE;
 }
 
-static void sayHello(void) {
+static void sayHello(hello_instance_t* instance) {
   u32 l0 = 0, l1 = 0;
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0, i1;
   i0 = 1024u;
   l0 = i0;
@@ -280,19 +454,32 @@ static void sayHello(void) {
   l1 = i0;
   i0 = l0;
   i1 = l1;
-  i0 = f11(i0, i1);
+  i0 = f11(instance, i0, i1);
   goto Bfunc;
   Bfunc:;
   FUNC_EPILOGUE;
 }
 
-static f64 add(f64 p0, f64 p1) {
+#if HELLO_PROMOTE_SLOTS
+/* Both arguments only pass through two slots below g0, which add never
+ * publishes (it does not lower g0 and calls nothing), so they stay in
+ * locals. */
+static f64 add(hello_instance_t* instance, f64 p0, f64 p1) {
+  LEAF_PROLOGUE;
+  f64 d0;
+  d0 = p0 + p1;
+  LEAF_EPILOGUE;
+  return d0;
+}
+#else
+static f64 add(hello_instance_t* instance, f64 p0, f64 p1) {
   u32 l2 = 0, l3 = 0, l4 = 0;
   f64 l5 = 0, l6 = 0, l7 = 0;
-  FUNC_PROLOGUE;
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1;
   f64 d0, d1;
-  i0 = g0;
+  i0 = instance->globals.g0;
   l2 = i0;
   i0 = 16u;
   l3 = i0;
@@ -302,15 +489,15 @@ static f64 add(f64 p0, f64 p1) {
   l4 = i0;
   i0 = l4;
   d1 = p0;
-  f64_store(Z_envZ_memory, (u64)(i0 + 8), d1);
+  f64_store(instance->Z_envZ_memory, (u64)(i0 + 8), d1);
   i0 = l4;
   d1 = p1;
-  f64_store(Z_envZ_memory, (u64)(i0), d1);
+  f64_store(instance->Z_envZ_memory, (u64)(i0), d1);
   i0 = l4;
-  d0 = f64_load(Z_envZ_memory, (u64)(i0 + 8));
+  d0 = f64_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   l5 = d0;
   i0 = l4;
-  d0 = f64_load(Z_envZ_memory, (u64)(i0));
+  d0 = f64_load(instance->Z_envZ_memory, (u64)(i0));
   l6 = d0;
   d0 = l5;
   d1 = l6;
@@ -319,17 +506,20 @@ static f64 add(f64 p0, f64 p1) {
   d0 = l7;
   goto Bfunc;
   Bfunc:;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return d0;
 }
+#endif
 
-static u32 greet(u32 p0) {
+static u32 greet(hello_instance_t* instance, u32 p0) {
   u32 l1 = 0, l2 = 0, l3 = 0, l4 = 0, l5 = 0, l6 = 0, l7 = 0, l8 = 0, 
       l9 = 0, l10 = 0, l11 = 0, l12 = 0, l13 = 0, l14 = 0, l15 = 0, l16 = 0, 
       l17 = 0, l18 = 0, l19 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1;
-  i0 = g0;
+  i0 = instance->globals.g0;
   l1 = i0;
   i0 = 288u;
   l2 = i0;
@@ -338,21 +528,21 @@ static u32 greet(u32 p0) {
   i0 -= i1;
   l3 = i0;
   i0 = l3;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = l3;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 284), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 284), i1);
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 284));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 284));
   l4 = i0;
   i0 = l3;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = 1039u;
   l5 = i0;
   i0 = l5;
   i1 = l3;
-  i0 = f11(i0, i1);
+  i0 = f11(instance, i0, i1);
   i0 = 1058u;
   l6 = i0;
   i0 = 16u;
@@ -366,39 +556,39 @@ static u32 greet(u32 p0) {
   i0 = 256u;
   l10 = i0;
   i0 = l10;
-  i0 = malloc(i0);
+  i0 = malloc(instance, i0);
   l11 = i0;
   i0 = l3;
   i1 = l11;
-  i32_store(Z_envZ_memory, (u64)(i0 + 280), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 280), i1);
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 280));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 280));
   l12 = i0;
   i0 = 1050u;
   l13 = i0;
   i0 = l12;
   i1 = l13;
-  i0 = f44(i0, i1);
+  i0 = f44(instance, i0, i1);
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 284));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 284));
   l14 = i0;
   i0 = l9;
   i1 = l14;
-  i0 = f44(i0, i1);
+  i0 = f44(instance, i0, i1);
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 280));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 280));
   l15 = i0;
   i0 = l15;
   i1 = l9;
-  i0 = f42(i0, i1);
+  i0 = f42(instance, i0, i1);
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 280));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 280));
   l16 = i0;
   i0 = l16;
   i1 = l6;
-  i0 = f42(i0, i1);
+  i0 = f42(instance, i0, i1);
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 280));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 280));
   l17 = i0;
   i0 = 288u;
   l18 = i0;
@@ -407,7 +597,7 @@ static u32 greet(u32 p0) {
   i0 += i1;
   l19 = i0;
   i0 = l19;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = l17;
   goto Bfunc;
   Bfunc:;
@@ -415,63 +605,67 @@ static u32 greet(u32 p0) {
   return i0;
 }
 
-static u32 f11(u32 p0, u32 p1) {
+static u32 f11(hello_instance_t* instance, u32 p0, u32 p1) {
   u32 l2 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2;
-  i0 = g0;
+  i0 = instance->globals.g0;
   i1 = 16u;
   i0 -= i1;
   l2 = i0;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = l2;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 1060));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 1060));
   i1 = p0;
   i2 = p1;
-  i0 = f37(i0, i1, i2);
+  i0 = f37(instance, i0, i1, i2);
   p1 = i0;
   i0 = l2;
   i1 = 16u;
   i0 += i1;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = p1;
   FUNC_EPILOGUE;
   return i0;
 }
 
-static u32 f12(u32 p0, u32 p1, u32 p2) {
+static u32 f12(hello_instance_t* instance, u32 p0, u32 p1, u32 p2) {
   u32 l3 = 0, l4 = 0, l5 = 0, l6 = 0, l7 = 0, l8 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2, i3, i4, i5;
   u64 j1;
-  i0 = g0;
+  i0 = instance->globals.g0;
   i1 = 32u;
   i0 -= i1;
   l3 = i0;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = l3;
   i1 = p0;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 28));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 28));
   l4 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 16), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 16), i1);
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 20));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 20));
   l5 = i0;
   i0 = l3;
   i1 = p2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 28), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 28), i1);
   i0 = l3;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   i0 = l3;
   i1 = l5;
   i2 = l4;
   i1 -= i2;
   p1 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 20), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 20), i1);
   i0 = p1;
   i1 = p2;
   i0 += i1;
@@ -483,26 +677,27 @@ static u32 f12(u32 p0, u32 p1, u32 p2) {
   i0 += i1;
   p1 = i0;
   L0: 
+    EPOCH_CHECK;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 60));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 60));
     i1 = p1;
     i2 = l5;
     i3 = l3;
     i4 = 12u;
     i3 += i4;
-    i0 = (*Z_wasi_unstableZ_fd_writeZ_iiiii)(i0, i1, i2, i3);
-    i0 = f46(i0);
+    i0 = (*Z_wasi_unstableZ_fd_writeZ_iiiii)(instance, i0, i1, i2, i3);
+    i0 = f46(instance, i0);
     i0 = !(i0);
     if (i0) {goto B2;}
     i0 = 4294967295u;
     l4 = i0;
     i0 = l3;
     i1 = 4294967295u;
-    i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
     goto B1;
     B2:;
     i0 = l3;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
     l4 = i0;
     B1:;
     i0 = l6;
@@ -511,18 +706,18 @@ static u32 f12(u32 p0, u32 p1, u32 p2) {
     if (i0) {goto B5;}
     i0 = p0;
     i1 = p0;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 44));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 44));
     p1 = i1;
-    i32_store(Z_envZ_memory, (u64)(i0 + 28), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 28), i1);
     i0 = p0;
     i1 = p1;
-    i32_store(Z_envZ_memory, (u64)(i0 + 20), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 20), i1);
     i0 = p0;
     i1 = p1;
     i2 = p0;
-    i2 = i32_load(Z_envZ_memory, (u64)(i2 + 48));
+    i2 = i32_load(instance->Z_envZ_memory, (u64)(i2 + 48));
     i1 += i2;
-    i32_store(Z_envZ_memory, (u64)(i0 + 16), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 16), i1);
     i0 = p2;
     l4 = i0;
     goto B4;
@@ -535,30 +730,30 @@ static u32 f12(u32 p0, u32 p1, u32 p2) {
     l4 = i0;
     i0 = p0;
     i1 = 0u;
-    i32_store(Z_envZ_memory, (u64)(i0 + 28), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 28), i1);
     i0 = p0;
     j1 = 0ull;
-    i64_store(Z_envZ_memory, (u64)(i0 + 16), j1);
+    i64_store(instance->Z_envZ_memory, (u64)(i0 + 16), j1);
     i0 = p0;
     i1 = p0;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
     i2 = 32u;
     i1 |= i2;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = l5;
     i1 = 2u;
     i0 = i0 == i1;
     if (i0) {goto B4;}
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 4));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 4));
     i0 -= i1;
     l4 = i0;
     B4:;
     i0 = l3;
     i1 = 32u;
     i0 += i1;
-    g0 = i0;
+    instance->globals.g0 = i0;
     i0 = l4;
     goto Bfunc;
     B3:;
@@ -568,14 +763,14 @@ static u32 f12(u32 p0, u32 p1, u32 p2) {
     i1 = p1;
     i2 = l4;
     i3 = p1;
-    i3 = i32_load(Z_envZ_memory, (u64)(i3 + 4));
+    i3 = i32_load(instance->Z_envZ_memory, (u64)(i3 + 4));
     l7 = i3;
     i2 = i2 > i3;
     l8 = i2;
     i0 = i2 ? i0 : i1;
     p1 = i0;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
     i2 = l4;
     i3 = l7;
     i4 = 0u;
@@ -584,13 +779,13 @@ static u32 f12(u32 p0, u32 p1, u32 p2) {
     i2 -= i3;
     l7 = i2;
     i1 += i2;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = p1;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 4));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 4));
     i2 = l7;
     i1 -= i2;
-    i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
     i0 = l6;
     i1 = l4;
     i0 -= i1;
@@ -605,66 +800,68 @@ static u32 f12(u32 p0, u32 p1, u32 p2) {
   return i0;
 }
 
-static u32 f13(u32 p0) {
-  FUNC_PROLOGUE;
+static u32 f13(hello_instance_t* instance, u32 p0) {
+  LEAF_PROLOGUE;
   u32 i0;
   i0 = 0u;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u64 f14(u32 p0, u64 p1, u32 p2) {
-  FUNC_PROLOGUE;
+static u64 f14(hello_instance_t* instance, u32 p0, u64 p1, u32 p2) {
+  LEAF_PROLOGUE;
   u64 j0;
   j0 = 0ull;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return j0;
 }
 
-static u32 f15(u32 p0) {
-  FUNC_PROLOGUE;
+static u32 f15(hello_instance_t* instance, u32 p0) {
+  LEAF_PROLOGUE;
   u32 i0;
   i0 = 1u;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static void f16(u32 p0) {
-  FUNC_PROLOGUE;
-  FUNC_EPILOGUE;
+static void f16(hello_instance_t* instance, u32 p0) {
+  LEAF_PROLOGUE;
+  LEAF_EPILOGUE;
 }
 
-static u32 __errno_location(void) {
-  FUNC_PROLOGUE;
+static u32 __errno_location(hello_instance_t* instance) {
+  LEAF_PROLOGUE;
   u32 i0;
   i0 = 3032u;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u32 f18(u32 p0) {
-  FUNC_PROLOGUE;
+static u32 f18(hello_instance_t* instance, u32 p0) {
+  LEAF_PROLOGUE;
   u32 i0, i1;
   i0 = p0;
   i1 = 4294967248u;
   i0 += i1;
   i1 = 10u;
   i0 = i0 < i1;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u32 f19(void) {
-  FUNC_PROLOGUE;
+static u32 f19(hello_instance_t* instance) {
+  LEAF_PROLOGUE;
   u32 i0;
   i0 = 1756u;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u32 f20(u32 p0, u32 p1, u32 p2) {
+static u32 f20(hello_instance_t* instance, u32 p0, u32 p1, u32 p2) {
   u32 l3 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2;
   i0 = 1u;
   l3 = i0;
@@ -675,9 +872,9 @@ static u32 f20(u32 p0, u32 p1, u32 p2) {
   i1 = 127u;
   i0 = i0 <= i1;
   if (i0) {goto B0;}
-  i0 = f21();
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 188));
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = f21(instance);
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 188));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   if (i0) {goto B3;}
   i0 = p1;
   i1 = 4294967168u;
@@ -685,9 +882,9 @@ static u32 f20(u32 p0, u32 p1, u32 p2) {
   i1 = 57216u;
   i0 = i0 == i1;
   if (i0) {goto B0;}
-  i0 = __errno_location();
+  i0 = __errno_location(instance);
   i1 = 25u;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   goto B2;
   B3:;
   i0 = p1;
@@ -700,14 +897,14 @@ static u32 f20(u32 p0, u32 p1, u32 p2) {
   i1 &= i2;
   i2 = 128u;
   i1 |= i2;
-  i32_store8(Z_envZ_memory, (u64)(i0 + 1), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0 + 1), i1);
   i0 = p0;
   i1 = p1;
   i2 = 6u;
   i1 >>= (i2 & 31);
   i2 = 192u;
   i1 |= i2;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = 2u;
   goto Bfunc;
   B4:;
@@ -728,14 +925,14 @@ static u32 f20(u32 p0, u32 p1, u32 p2) {
   i1 &= i2;
   i2 = 128u;
   i1 |= i2;
-  i32_store8(Z_envZ_memory, (u64)(i0 + 2), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0 + 2), i1);
   i0 = p0;
   i1 = p1;
   i2 = 12u;
   i1 >>= (i2 & 31);
   i2 = 224u;
   i1 |= i2;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
   i2 = 6u;
@@ -744,7 +941,7 @@ static u32 f20(u32 p0, u32 p1, u32 p2) {
   i1 &= i2;
   i2 = 128u;
   i1 |= i2;
-  i32_store8(Z_envZ_memory, (u64)(i0 + 1), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0 + 1), i1);
   i0 = 3u;
   goto Bfunc;
   B5:;
@@ -760,14 +957,14 @@ static u32 f20(u32 p0, u32 p1, u32 p2) {
   i1 &= i2;
   i2 = 128u;
   i1 |= i2;
-  i32_store8(Z_envZ_memory, (u64)(i0 + 3), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0 + 3), i1);
   i0 = p0;
   i1 = p1;
   i2 = 18u;
   i1 >>= (i2 & 31);
   i2 = 240u;
   i1 |= i2;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
   i2 = 6u;
@@ -776,7 +973,7 @@ static u32 f20(u32 p0, u32 p1, u32 p2) {
   i1 &= i2;
   i2 = 128u;
   i1 |= i2;
-  i32_store8(Z_envZ_memory, (u64)(i0 + 2), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0 + 2), i1);
   i0 = p0;
   i1 = p1;
   i2 = 12u;
@@ -785,13 +982,13 @@ static u32 f20(u32 p0, u32 p1, u32 p2) {
   i1 &= i2;
   i2 = 128u;
   i1 |= i2;
-  i32_store8(Z_envZ_memory, (u64)(i0 + 1), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0 + 1), i1);
   i0 = 4u;
   goto Bfunc;
   B7:;
-  i0 = __errno_location();
+  i0 = __errno_location(instance);
   i1 = 25u;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   B2:;
   i0 = 4294967295u;
   l3 = i0;
@@ -801,23 +998,25 @@ static u32 f20(u32 p0, u32 p1, u32 p2) {
   B0:;
   i0 = p0;
   i1 = p1;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = 1u;
   Bfunc:;
   FUNC_EPILOGUE;
   return i0;
 }
 
-static u32 f21(void) {
+static u32 f21(hello_instance_t* instance) {
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0;
-  i0 = f19();
+  i0 = f19(instance);
   FUNC_EPILOGUE;
   return i0;
 }
 
-static u32 f22(u32 p0, u32 p1) {
+static u32 f22(hello_instance_t* instance, u32 p0, u32 p1) {
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0, i1, i2;
   i0 = p0;
   if (i0) {goto B0;}
@@ -827,16 +1026,18 @@ static u32 f22(u32 p0, u32 p1) {
   i0 = p0;
   i1 = p1;
   i2 = 0u;
-  i0 = f20(i0, i1, i2);
+  i0 = f20(instance, i0, i1, i2);
   Bfunc:;
   FUNC_EPILOGUE;
   return i0;
 }
 
-static f64 f23(f64 p0, u32 p1) {
+static f64 f23(hello_instance_t* instance, f64 p0, u32 p1) {
   u32 l2 = 0;
   u64 l3 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2;
   u64 j0, j1;
   f64 d0, d1;
@@ -866,17 +1067,17 @@ static f64 f23(f64 p0, u32 p1) {
   d1 = 1.8446744073709552e+19;
   d0 *= d1;
   i1 = p1;
-  d0 = f23(d0, i1);
+  d0 = f23(instance, d0, i1);
   p0 = d0;
   i0 = p1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   i1 = 4294967232u;
   i0 += i1;
   l2 = i0;
   B2:;
   i0 = p1;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   d0 = p0;
   goto Bfunc;
   B1:;
@@ -884,7 +1085,7 @@ static f64 f23(f64 p0, u32 p1) {
   i1 = l2;
   i2 = 4294966274u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   j0 = l3;
   j1 = 9227875636482146303ull;
   j0 &= j1;
@@ -899,40 +1100,43 @@ static f64 f23(f64 p0, u32 p1) {
   return d0;
 }
 
-static u32 f24(void) {
+static u32 f24(hello_instance_t* instance) {
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0;
   i0 = 3100u;
-  (*Z_envZ___lockZ_vi)(i0);
+  (*Z_envZ___lockZ_vi)(instance, i0);
   i0 = 3108u;
   FUNC_EPILOGUE;
   return i0;
 }
 
-static void f25(void) {
+static void f25(hello_instance_t* instance) {
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0;
   i0 = 3100u;
-  (*Z_envZ___unlockZ_vi)(i0);
+  (*Z_envZ___unlockZ_vi)(instance, i0);
   FUNC_EPILOGUE;
 }
 
-static u32 f26(u32 p0) {
+static u32 f26(hello_instance_t* instance, u32 p0) {
   u32 l1 = 0;
-  FUNC_PROLOGUE;
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1, i2;
   u64 j1;
   i0 = p0;
   i1 = p0;
-  i1 = i32_load8_u(Z_envZ_memory, (u64)(i1 + 74));
+  i1 = i32_load8_u(instance->Z_envZ_memory, (u64)(i1 + 74));
   l1 = i1;
   i2 = 4294967295u;
   i1 += i2;
   i2 = l1;
   i1 |= i2;
-  i32_store8(Z_envZ_memory, (u64)(i0 + 74), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0 + 74), i1);
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l1 = i0;
   i1 = 8u;
   i0 &= i1;
@@ -942,53 +1146,55 @@ static u32 f26(u32 p0) {
   i1 = l1;
   i2 = 32u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = 4294967295u;
   goto Bfunc;
   B0:;
   i0 = p0;
   j1 = 0ull;
-  i64_store(Z_envZ_memory, (u64)(i0 + 4), j1);
+  i64_store(instance->Z_envZ_memory, (u64)(i0 + 4), j1);
   i0 = p0;
   i1 = p0;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 44));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 44));
   l1 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 28), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 28), i1);
   i0 = p0;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 20), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 20), i1);
   i0 = p0;
   i1 = l1;
   i2 = p0;
-  i2 = i32_load(Z_envZ_memory, (u64)(i2 + 48));
+  i2 = i32_load(instance->Z_envZ_memory, (u64)(i2 + 48));
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 16), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 16), i1);
   i0 = 0u;
   Bfunc:;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u32 f27(u32 p0, u32 p1, u32 p2) {
+static u32 f27(hello_instance_t* instance, u32 p0, u32 p1, u32 p2) {
   u32 l3 = 0, l4 = 0, l5 = 0, l6 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2, i3;
   i0 = p2;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
   l3 = i0;
   if (i0) {goto B1;}
   i0 = 0u;
   l4 = i0;
   i0 = p2;
-  i0 = f26(i0);
+  i0 = f26(instance, i0);
   if (i0) {goto B0;}
   i0 = p2;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
   l3 = i0;
   B1:;
   i0 = l3;
   i1 = p2;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 20));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 20));
   l5 = i1;
   i0 -= i1;
   i1 = p1;
@@ -998,20 +1204,21 @@ static u32 f27(u32 p0, u32 p1, u32 p2) {
   i1 = p0;
   i2 = p1;
   i3 = p2;
-  i3 = i32_load(Z_envZ_memory, (u64)(i3 + 36));
-  i0 = CALL_INDIRECT((*Z_envZ_table), u32 (*)(u32, u32, u32), 0, i3, i0, i1, i2);
+  i3 = i32_load(instance->Z_envZ_memory, (u64)(i3 + 36));
+  i0 = CALL_INDIRECT_DIRECT((*instance->Z_envZ_table), u32 (*)(hello_instance_t*, u32, u32, u32), 0, i3, 2, f12, instance, i0, i1, i2);
   goto Bfunc;
   B2:;
   i0 = 0u;
   l6 = i0;
   i0 = p2;
-  i0 = i32_load8_s(Z_envZ_memory, (u64)(i0 + 75));
+  i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0 + 75));
   i1 = 0u;
   i0 = (u32)((s32)i0 < (s32)i1);
   if (i0) {goto B3;}
   i0 = p1;
   l4 = i0;
   L4: 
+    EPOCH_CHECK;
     i0 = l4;
     l3 = i0;
     i0 = !(i0);
@@ -1022,7 +1229,7 @@ static u32 f27(u32 p0, u32 p1, u32 p2) {
     i1 += i2;
     l4 = i1;
     i0 += i1;
-    i0 = i32_load8_u(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0));
     i1 = 10u;
     i0 = i0 != i1;
     if (i0) {goto L4;}
@@ -1030,8 +1237,8 @@ static u32 f27(u32 p0, u32 p1, u32 p2) {
   i1 = p0;
   i2 = l3;
   i3 = p2;
-  i3 = i32_load(Z_envZ_memory, (u64)(i3 + 36));
-  i0 = CALL_INDIRECT((*Z_envZ_table), u32 (*)(u32, u32, u32), 0, i3, i0, i1, i2);
+  i3 = i32_load(instance->Z_envZ_memory, (u64)(i3 + 36));
+  i0 = CALL_INDIRECT_DIRECT((*instance->Z_envZ_table), u32 (*)(hello_instance_t*, u32, u32, u32), 0, i3, 2, f12, instance, i0, i1, i2);
   l4 = i0;
   i1 = l3;
   i0 = i0 < i1;
@@ -1045,7 +1252,7 @@ static u32 f27(u32 p0, u32 p1, u32 p2) {
   i0 += i1;
   p0 = i0;
   i0 = p2;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 20));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 20));
   l5 = i0;
   i0 = l3;
   l6 = i0;
@@ -1053,13 +1260,13 @@ static u32 f27(u32 p0, u32 p1, u32 p2) {
   i0 = l5;
   i1 = p0;
   i2 = p1;
-  i0 = f53(i0, i1, i2);
+  i0 = f53(instance, i0, i1, i2);
   i0 = p2;
   i1 = p2;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 20));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 20));
   i2 = p1;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 20), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 20), i1);
   i0 = l6;
   i1 = p1;
   i0 += i1;
@@ -1071,18 +1278,20 @@ static u32 f27(u32 p0, u32 p1, u32 p2) {
   return i0;
 }
 
-static u32 f28(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
+static u32 f28(hello_instance_t* instance, u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   u32 l5 = 0, l6 = 0, l7 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2, i3, i4, i5, i6;
-  i0 = g0;
+  i0 = instance->globals.g0;
   i1 = 208u;
   i0 -= i1;
   l5 = i0;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = l5;
   i1 = p2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 204), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 204), i1);
   i0 = 0u;
   p2 = i0;
   i0 = l5;
@@ -1090,11 +1299,11 @@ static u32 f28(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   i0 += i1;
   i1 = 0u;
   i2 = 40u;
-  i0 = f54(i0, i1, i2);
+  i0 = f54(instance, i0, i1, i2);
   i0 = l5;
   i1 = l5;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 204));
-  i32_store(Z_envZ_memory, (u64)(i0 + 200), i1);
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 204));
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 200), i1);
   i0 = 0u;
   i1 = p1;
   i2 = l5;
@@ -1108,7 +1317,7 @@ static u32 f28(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   i4 += i5;
   i5 = p3;
   i6 = p4;
-  i0 = f29(i0, i1, i2, i3, i4, i5, i6);
+  i0 = f29(instance, i0, i1, i2, i3, i4, i5, i6);
   i1 = 0u;
   i0 = (u32)((s32)i0 >= (s32)i1);
   if (i0) {goto B1;}
@@ -1117,19 +1326,19 @@ static u32 f28(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   goto B0;
   B1:;
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 76));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 76));
   i1 = 0u;
   i0 = (u32)((s32)i0 < (s32)i1);
   if (i0) {goto B2;}
   i0 = p0;
-  i0 = f15(i0);
+  i0 = f15(instance, i0);
   p2 = i0;
   B2:;
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l6 = i0;
   i0 = p0;
-  i0 = i32_load8_s(Z_envZ_memory, (u64)(i0 + 74));
+  i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0 + 74));
   i1 = 0u;
   i0 = (u32)((s32)i0 > (s32)i1);
   if (i0) {goto B3;}
@@ -1137,14 +1346,14 @@ static u32 f28(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   i1 = l6;
   i2 = 4294967263u;
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   B3:;
   i0 = l6;
   i1 = 32u;
   i0 &= i1;
   l6 = i0;
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 48));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 48));
   i0 = !(i0);
   if (i0) {goto B5;}
   i0 = p0;
@@ -1160,30 +1369,30 @@ static u32 f28(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   i4 += i5;
   i5 = p3;
   i6 = p4;
-  i0 = f29(i0, i1, i2, i3, i4, i5, i6);
+  i0 = f29(instance, i0, i1, i2, i3, i4, i5, i6);
   p1 = i0;
   goto B4;
   B5:;
   i0 = p0;
   i1 = 80u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 48), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 48), i1);
   i0 = p0;
   i1 = l5;
   i2 = 80u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 16), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 16), i1);
   i0 = p0;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 28), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 28), i1);
   i0 = p0;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 20), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 20), i1);
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 44));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 44));
   l7 = i0;
   i0 = p0;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 44), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 44), i1);
   i0 = p0;
   i1 = p1;
   i2 = l5;
@@ -1197,7 +1406,7 @@ static u32 f28(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   i4 += i5;
   i5 = p3;
   i6 = p4;
-  i0 = f29(i0, i1, i2, i3, i4, i5, i6);
+  i0 = f29(instance, i0, i1, i2, i3, i4, i5, i6);
   p1 = i0;
   i0 = l7;
   i0 = !(i0);
@@ -1206,26 +1415,26 @@ static u32 f28(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   i1 = 0u;
   i2 = 0u;
   i3 = p0;
-  i3 = i32_load(Z_envZ_memory, (u64)(i3 + 36));
-  i0 = CALL_INDIRECT((*Z_envZ_table), u32 (*)(u32, u32, u32), 0, i3, i0, i1, i2);
+  i3 = i32_load(instance->Z_envZ_memory, (u64)(i3 + 36));
+  i0 = CALL_INDIRECT_DIRECT((*instance->Z_envZ_table), u32 (*)(hello_instance_t*, u32, u32, u32), 0, i3, 2, f12, instance, i0, i1, i2);
   i0 = p0;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 48), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 48), i1);
   i0 = p0;
   i1 = l7;
-  i32_store(Z_envZ_memory, (u64)(i0 + 44), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 44), i1);
   i0 = p0;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 28), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 28), i1);
   i0 = p0;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 16), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 16), i1);
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 20));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 20));
   p3 = i0;
   i0 = p0;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 20), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 20), i1);
   i0 = p1;
   i1 = 4294967295u;
   i2 = p3;
@@ -1234,11 +1443,11 @@ static u32 f28(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   B4:;
   i0 = p0;
   i1 = p0;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   p3 = i1;
   i2 = l6;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = 4294967295u;
   i1 = p1;
   i2 = p3;
@@ -1250,33 +1459,35 @@ static u32 f28(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   i0 = !(i0);
   if (i0) {goto B0;}
   i0 = p0;
-  f16(i0);
+  f16(instance, i0);
   B0:;
   i0 = l5;
   i1 = 208u;
   i0 += i1;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = p1;
   FUNC_EPILOGUE;
   return i0;
 }
 
-static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
+static u32 f29(hello_instance_t* instance, u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
   u32 l7 = 0, l8 = 0, l9 = 0, l10 = 0, l11 = 0, l12 = 0, l13 = 0, l14 = 0, 
       l15 = 0, l16 = 0, l17 = 0, l18 = 0, l19 = 0, l20 = 0, l21 = 0;
   u64 l22 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2, i3, i4, i5, i6;
   u64 j0, j1, j2;
   f64 d1;
-  i0 = g0;
+  i0 = instance->globals.g0;
   i1 = 80u;
   i0 -= i1;
   l7 = i0;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = l7;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 76), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 76), i1);
   i0 = l7;
   i1 = 55u;
   i0 += i1;
@@ -1292,6 +1503,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
   i0 = 0u;
   p1 = i0;
   L2: 
+    EPOCH_CHECK;
     i0 = l11;
     i1 = 0u;
     i0 = (u32)((s32)i0 < (s32)i1);
@@ -1302,9 +1514,9 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     i1 -= i2;
     i0 = (u32)((s32)i0 <= (s32)i1);
     if (i0) {goto B4;}
-    i0 = __errno_location();
+    i0 = __errno_location(instance);
     i1 = 61u;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = 4294967295u;
     l11 = i0;
     goto B3;
@@ -1315,15 +1527,16 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     l11 = i0;
     B3:;
     i0 = l7;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 76));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 76));
     l12 = i0;
     p1 = i0;
     i0 = l12;
-    i0 = i32_load8_u(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0));
     l13 = i0;
     i0 = !(i0);
     if (i0) {goto B18;}
     L20: 
+      EPOCH_CHECK;
       i0 = l13;
       i1 = 255u;
       i0 &= i1;
@@ -1340,8 +1553,9 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i0 = p1;
       l13 = i0;
       L24: 
+        EPOCH_CHECK;
         i0 = p1;
-        i0 = i32_load8_u(Z_envZ_memory, (u64)(i0 + 1));
+        i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0 + 1));
         i1 = 37u;
         i0 = i0 != i1;
         if (i0) {goto B22;}
@@ -1350,13 +1564,13 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
         i2 = 2u;
         i1 += i2;
         l14 = i1;
-        i32_store(Z_envZ_memory, (u64)(i0 + 76), i1);
+        i32_store(instance->Z_envZ_memory, (u64)(i0 + 76), i1);
         i0 = l13;
         i1 = 1u;
         i0 += i1;
         l13 = i0;
         i0 = p1;
-        i0 = i32_load8_u(Z_envZ_memory, (u64)(i0 + 2));
+        i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0 + 2));
         l15 = i0;
         i0 = l14;
         p1 = i0;
@@ -1375,32 +1589,32 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i0 = p0;
       i1 = l12;
       i2 = p1;
-      f30(i0, i1, i2);
+      f30(instance, i0, i1, i2);
       B25:;
       i0 = p1;
       if (i0) {goto L2;}
       i0 = l7;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0 + 76));
-      i0 = i32_load8_s(Z_envZ_memory, (u64)(i0 + 1));
-      i0 = f18(i0);
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 76));
+      i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0 + 1));
+      i0 = f18(instance, i0);
       l14 = i0;
       i0 = 4294967295u;
       l16 = i0;
       i0 = 1u;
       l13 = i0;
       i0 = l7;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0 + 76));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 76));
       p1 = i0;
       i0 = l14;
       i0 = !(i0);
       if (i0) {goto B26;}
       i0 = p1;
-      i0 = i32_load8_u(Z_envZ_memory, (u64)(i0 + 2));
+      i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0 + 2));
       i1 = 36u;
       i0 = i0 != i1;
       if (i0) {goto B26;}
       i0 = p1;
-      i0 = i32_load8_s(Z_envZ_memory, (u64)(i0 + 1));
+      i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0 + 1));
       i1 = 4294967248u;
       i0 += i1;
       l16 = i0;
@@ -1414,11 +1628,11 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i2 = l13;
       i1 += i2;
       p1 = i1;
-      i32_store(Z_envZ_memory, (u64)(i0 + 76), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0 + 76), i1);
       i0 = 0u;
       l13 = i0;
       i0 = p1;
-      i0 = i32_load8_s(Z_envZ_memory, (u64)(i0));
+      i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0));
       l17 = i0;
       i1 = 4294967264u;
       i0 += i1;
@@ -1441,18 +1655,19 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i0 = !(i0);
       if (i0) {goto B27;}
       L29: 
+        EPOCH_CHECK;
         i0 = l7;
         i1 = p1;
         i2 = 1u;
         i1 += i2;
         l14 = i1;
-        i32_store(Z_envZ_memory, (u64)(i0 + 76), i1);
+        i32_store(instance->Z_envZ_memory, (u64)(i0 + 76), i1);
         i0 = l15;
         i1 = l13;
         i0 |= i1;
         l13 = i0;
         i0 = p1;
-        i0 = i32_load8_s(Z_envZ_memory, (u64)(i0 + 1));
+        i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0 + 1));
         l17 = i0;
         i1 = 4294967264u;
         i0 += i1;
@@ -1475,19 +1690,19 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i0 = i0 != i1;
       if (i0) {goto B31;}
       i0 = l14;
-      i0 = i32_load8_s(Z_envZ_memory, (u64)(i0 + 1));
-      i0 = f18(i0);
+      i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0 + 1));
+      i0 = f18(instance, i0);
       i0 = !(i0);
       if (i0) {goto B33;}
       i0 = l7;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0 + 76));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 76));
       l14 = i0;
-      i0 = i32_load8_u(Z_envZ_memory, (u64)(i0 + 2));
+      i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0 + 2));
       i1 = 36u;
       i0 = i0 != i1;
       if (i0) {goto B33;}
       i0 = l14;
-      i0 = i32_load8_s(Z_envZ_memory, (u64)(i0 + 1));
+      i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0 + 1));
       i1 = 2u;
       i0 <<= (i1 & 31);
       i1 = p4;
@@ -1495,20 +1710,20 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i1 = 4294967104u;
       i0 += i1;
       i1 = 10u;
-      i32_store(Z_envZ_memory, (u64)(i0), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
       i0 = l14;
       i1 = 3u;
       i0 += i1;
       p1 = i0;
       i0 = l14;
-      i0 = i32_load8_s(Z_envZ_memory, (u64)(i0 + 1));
+      i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0 + 1));
       i1 = 3u;
       i0 <<= (i1 & 31);
       i1 = p3;
       i0 += i1;
       i1 = 4294966912u;
       i0 += i1;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
       l18 = i0;
       i0 = 1u;
       l10 = i0;
@@ -1525,24 +1740,24 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       if (i0) {goto B34;}
       i0 = p2;
       i1 = p2;
-      i1 = i32_load(Z_envZ_memory, (u64)(i1));
+      i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
       p1 = i1;
       i2 = 4u;
       i1 += i2;
-      i32_store(Z_envZ_memory, (u64)(i0), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
       i0 = p1;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
       l18 = i0;
       B34:;
       i0 = l7;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0 + 76));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 76));
       i1 = 1u;
       i0 += i1;
       p1 = i0;
       B32:;
       i0 = l7;
       i1 = p1;
-      i32_store(Z_envZ_memory, (u64)(i0 + 76), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0 + 76), i1);
       i0 = l18;
       i1 = 4294967295u;
       i0 = (u32)((s32)i0 > (s32)i1);
@@ -1560,41 +1775,41 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i0 = l7;
       i1 = 76u;
       i0 += i1;
-      i0 = f31(i0);
+      i0 = f31(instance, i0);
       l18 = i0;
       i1 = 0u;
       i0 = (u32)((s32)i0 < (s32)i1);
       if (i0) {goto B1;}
       i0 = l7;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0 + 76));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 76));
       p1 = i0;
       B30:;
       i0 = 4294967295u;
       l19 = i0;
       i0 = p1;
-      i0 = i32_load8_u(Z_envZ_memory, (u64)(i0));
+      i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0));
       i1 = 46u;
       i0 = i0 != i1;
       if (i0) {goto B35;}
       i0 = p1;
-      i0 = i32_load8_u(Z_envZ_memory, (u64)(i0 + 1));
+      i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0 + 1));
       i1 = 42u;
       i0 = i0 != i1;
       if (i0) {goto B36;}
       i0 = p1;
-      i0 = i32_load8_s(Z_envZ_memory, (u64)(i0 + 2));
-      i0 = f18(i0);
+      i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0 + 2));
+      i0 = f18(instance, i0);
       i0 = !(i0);
       if (i0) {goto B37;}
       i0 = l7;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0 + 76));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 76));
       p1 = i0;
-      i0 = i32_load8_u(Z_envZ_memory, (u64)(i0 + 3));
+      i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0 + 3));
       i1 = 36u;
       i0 = i0 != i1;
       if (i0) {goto B37;}
       i0 = p1;
-      i0 = i32_load8_s(Z_envZ_memory, (u64)(i0 + 2));
+      i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0 + 2));
       i1 = 2u;
       i0 <<= (i1 & 31);
       i1 = p4;
@@ -1602,23 +1817,23 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i1 = 4294967104u;
       i0 += i1;
       i1 = 10u;
-      i32_store(Z_envZ_memory, (u64)(i0), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
       i0 = p1;
-      i0 = i32_load8_s(Z_envZ_memory, (u64)(i0 + 2));
+      i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0 + 2));
       i1 = 3u;
       i0 <<= (i1 & 31);
       i1 = p3;
       i0 += i1;
       i1 = 4294966912u;
       i0 += i1;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
       l19 = i0;
       i0 = l7;
       i1 = p1;
       i2 = 4u;
       i1 += i2;
       p1 = i1;
-      i32_store(Z_envZ_memory, (u64)(i0 + 76), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0 + 76), i1);
       goto B35;
       B37:;
       i0 = l10;
@@ -1631,47 +1846,48 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       B39:;
       i0 = p2;
       i1 = p2;
-      i1 = i32_load(Z_envZ_memory, (u64)(i1));
+      i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
       p1 = i1;
       i2 = 4u;
       i1 += i2;
-      i32_store(Z_envZ_memory, (u64)(i0), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
       i0 = p1;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
       l19 = i0;
       B38:;
       i0 = l7;
       i1 = l7;
-      i1 = i32_load(Z_envZ_memory, (u64)(i1 + 76));
+      i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 76));
       i2 = 2u;
       i1 += i2;
       p1 = i1;
-      i32_store(Z_envZ_memory, (u64)(i0 + 76), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0 + 76), i1);
       goto B35;
       B36:;
       i0 = l7;
       i1 = p1;
       i2 = 1u;
       i1 += i2;
-      i32_store(Z_envZ_memory, (u64)(i0 + 76), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0 + 76), i1);
       i0 = l7;
       i1 = 76u;
       i0 += i1;
-      i0 = f31(i0);
+      i0 = f31(instance, i0);
       l19 = i0;
       i0 = l7;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0 + 76));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 76));
       p1 = i0;
       B35:;
       i0 = 0u;
       l14 = i0;
       L40: 
+        EPOCH_CHECK;
         i0 = l14;
         l15 = i0;
         i0 = 4294967295u;
         l20 = i0;
         i0 = p1;
-        i0 = i32_load8_s(Z_envZ_memory, (u64)(i0));
+        i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0));
         i1 = 4294967231u;
         i0 += i1;
         i1 = 57u;
@@ -1682,9 +1898,9 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
         i2 = 1u;
         i1 += i2;
         l17 = i1;
-        i32_store(Z_envZ_memory, (u64)(i0 + 76), i1);
+        i32_store(instance->Z_envZ_memory, (u64)(i0 + 76), i1);
         i0 = p1;
-        i0 = i32_load8_s(Z_envZ_memory, (u64)(i0));
+        i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0));
         l14 = i0;
         i0 = l17;
         p1 = i0;
@@ -1695,7 +1911,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
         i0 += i1;
         i1 = 1023u;
         i0 += i1;
-        i0 = i32_load8_u(Z_envZ_memory, (u64)(i0));
+        i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0));
         l14 = i0;
         i1 = 4294967295u;
         i0 += i1;
@@ -1727,15 +1943,15 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i1 <<= (i2 & 31);
       i0 += i1;
       i1 = l14;
-      i32_store(Z_envZ_memory, (u64)(i0), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
       i0 = l7;
       i1 = p3;
       i2 = l16;
       i3 = 3u;
       i2 <<= (i3 & 31);
       i1 += i2;
-      j1 = i64_load(Z_envZ_memory, (u64)(i1));
-      i64_store(Z_envZ_memory, (u64)(i0 + 64), j1);
+      j1 = i64_load(instance->Z_envZ_memory, (u64)(i1));
+      i64_store(instance->Z_envZ_memory, (u64)(i0 + 64), j1);
       B43:;
       i0 = 0u;
       p1 = i0;
@@ -1753,9 +1969,9 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i1 = l14;
       i2 = p2;
       i3 = p6;
-      f32_0(i0, i1, i2, i3);
+      f32_0(instance, i0, i1, i2, i3);
       i0 = l7;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0 + 76));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 76));
       l17 = i0;
       B41:;
       i0 = l13;
@@ -1777,7 +1993,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i0 = l17;
       i1 = 4294967295u;
       i0 += i1;
-      i0 = i32_load8_s(Z_envZ_memory, (u64)(i0));
+      i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0));
       p1 = i0;
       i1 = 4294967263u;
       i0 &= i1;
@@ -1813,7 +2029,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i0 = !(i0);
       if (i0) {goto B48;}
       i0 = l7;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0 + 64));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 64));
       l14 = i0;
       goto B46;
       B49:;
@@ -1836,21 +2052,21 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i2 = l18;
       i3 = 0u;
       i4 = l13;
-      f33(i0, i1, i2, i3, i4);
+      f33(instance, i0, i1, i2, i3, i4);
       goto B45;
       B47:;
       i0 = l7;
       i1 = 0u;
-      i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
       i0 = l7;
       i1 = l7;
-      j1 = i64_load(Z_envZ_memory, (u64)(i1 + 64));
-      i64_store32(Z_envZ_memory, (u64)(i0 + 8), j1);
+      j1 = i64_load(instance->Z_envZ_memory, (u64)(i1 + 64));
+      i64_store32(instance->Z_envZ_memory, (u64)(i0 + 8), j1);
       i0 = l7;
       i1 = l7;
       i2 = 8u;
       i1 += i2;
-      i32_store(Z_envZ_memory, (u64)(i0 + 64), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0 + 64), i1);
       i0 = 4294967295u;
       l19 = i0;
       i0 = l7;
@@ -1861,8 +2077,9 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i0 = 0u;
       p1 = i0;
       L51: 
+        EPOCH_CHECK;
         i0 = l14;
-        i0 = i32_load(Z_envZ_memory, (u64)(i0));
+        i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
         l15 = i0;
         i0 = !(i0);
         if (i0) {goto B50;}
@@ -1870,7 +2087,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
         i1 = 4u;
         i0 += i1;
         i1 = l15;
-        i0 = f22(i0, i1);
+        i0 = f22(instance, i0, i1);
         l15 = i0;
         i1 = 0u;
         i0 = (u32)((s32)i0 < (s32)i1);
@@ -1905,7 +2122,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i2 = l18;
       i3 = p1;
       i4 = l13;
-      f33(i0, i1, i2, i3, i4);
+      f33(instance, i0, i1, i2, i3, i4);
       i0 = p1;
       if (i0) {goto B53;}
       i0 = 0u;
@@ -1915,11 +2132,12 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i0 = 0u;
       l15 = i0;
       i0 = l7;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0 + 64));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 64));
       l14 = i0;
       L54: 
+        EPOCH_CHECK;
         i0 = l14;
-        i0 = i32_load(Z_envZ_memory, (u64)(i0));
+        i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
         l12 = i0;
         i0 = !(i0);
         if (i0) {goto B45;}
@@ -1927,7 +2145,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
         i1 = 4u;
         i0 += i1;
         i1 = l12;
-        i0 = f22(i0, i1);
+        i0 = f22(instance, i0, i1);
         l12 = i0;
         i1 = l15;
         i0 += i1;
@@ -1940,7 +2158,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
         i2 = 4u;
         i1 += i2;
         i2 = l12;
-        f30(i0, i1, i2);
+        f30(instance, i0, i1, i2);
         i0 = l14;
         i1 = 4u;
         i0 += i1;
@@ -1957,7 +2175,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i4 = l13;
       i5 = 8192u;
       i4 ^= i5;
-      f33(i0, i1, i2, i3, i4);
+      f33(instance, i0, i1, i2, i3, i4);
       i0 = l18;
       i1 = p1;
       i2 = l18;
@@ -1972,9 +2190,9 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i2 = 1u;
       i1 += i2;
       l14 = i1;
-      i32_store(Z_envZ_memory, (u64)(i0 + 76), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0 + 76), i1);
       i0 = p1;
-      i0 = i32_load8_u(Z_envZ_memory, (u64)(i0 + 1));
+      i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0 + 1));
       l13 = i0;
       i0 = l14;
       p1 = i0;
@@ -2029,12 +2247,13 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     i0 = 1u;
     p1 = i0;
     L56: 
+      EPOCH_CHECK;
       i0 = p4;
       i1 = p1;
       i2 = 2u;
       i1 <<= (i2 & 31);
       i0 += i1;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
       l13 = i0;
       i0 = !(i0);
       if (i0) {goto B55;}
@@ -2046,7 +2265,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i1 = l13;
       i2 = p2;
       i3 = p6;
-      f32_0(i0, i1, i2, i3);
+      f32_0(instance, i0, i1, i2, i3);
       i0 = 1u;
       l20 = i0;
       i0 = p1;
@@ -2072,9 +2291,10 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     i2 = 2u;
     i1 <<= (i2 & 31);
     i0 += i1;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     if (i0) {goto B0;}
     L58: 
+      EPOCH_CHECK;
       i0 = p1;
       i1 = 1u;
       i0 += i1;
@@ -2087,7 +2307,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
       i2 = 2u;
       i1 <<= (i2 & 31);
       i0 += i1;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
       i0 = !(i0);
       if (i0) {goto L58;}
     B57:;
@@ -2102,20 +2322,20 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     B17:;
     i0 = p0;
     i1 = l7;
-    d1 = f64_load(Z_envZ_memory, (u64)(i1 + 64));
+    d1 = f64_load(instance->Z_envZ_memory, (u64)(i1 + 64));
     i2 = l18;
     i3 = l19;
     i4 = l13;
     i5 = p1;
     i6 = p5;
-    i0 = CALL_INDIRECT((*Z_envZ_table), u32 (*)(u32, f64, u32, u32, u32, u32), 1, i6, i0, d1, i2, i3, i4, i5);
+    i0 = CALL_INDIRECT_DIRECT((*instance->Z_envZ_table), u32 (*)(hello_instance_t*, u32, f64, u32, u32, u32, u32), 1, i6, 4, f38, instance, i0, d1, i2, i3, i4, i5);
     p1 = i0;
     goto L2;
     B16:;
     i0 = 0u;
     l20 = i0;
     i0 = l7;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 64));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     p1 = i0;
     i1 = 1074u;
     i2 = p1;
@@ -2123,7 +2343,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     l12 = i0;
     i1 = 0u;
     i2 = l19;
-    i0 = f41(i0, i1, i2);
+    i0 = f41(instance, i0, i1, i2);
     p1 = i0;
     i1 = l12;
     i2 = l19;
@@ -2144,8 +2364,8 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     B15:;
     i0 = l7;
     i1 = l7;
-    j1 = i64_load(Z_envZ_memory, (u64)(i1 + 64));
-    i64_store8(Z_envZ_memory, (u64)(i0 + 55), j1);
+    j1 = i64_load(instance->Z_envZ_memory, (u64)(i1 + 64));
+    i64_store8(instance->Z_envZ_memory, (u64)(i0 + 55), j1);
     i0 = 1u;
     l19 = i0;
     i0 = l8;
@@ -2157,7 +2377,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     goto B6;
     B14:;
     i0 = l7;
-    j0 = i64_load(Z_envZ_memory, (u64)(i0 + 64));
+    j0 = i64_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     l22 = j0;
     j1 = 18446744073709551615ull;
     i0 = (u64)((s64)j0 > (s64)j1);
@@ -2167,7 +2387,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     j2 = l22;
     j1 -= j2;
     l22 = j1;
-    i64_store(Z_envZ_memory, (u64)(i0 + 64), j1);
+    i64_store(instance->Z_envZ_memory, (u64)(i0 + 64), j1);
     i0 = 1u;
     l20 = i0;
     i0 = 1064u;
@@ -2196,9 +2416,9 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     goto B8;
     B13:;
     i0 = l7;
-    j0 = i64_load(Z_envZ_memory, (u64)(i0 + 64));
+    j0 = i64_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     i1 = l9;
-    i0 = f34(j0, i1);
+    i0 = f34(instance, j0, i1);
     l12 = i0;
     i0 = 0u;
     l20 = i0;
@@ -2238,12 +2458,12 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     p1 = i0;
     B11:;
     i0 = l7;
-    j0 = i64_load(Z_envZ_memory, (u64)(i0 + 64));
+    j0 = i64_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     i1 = l9;
     i2 = p1;
     i3 = 32u;
     i2 &= i3;
-    i0 = f35(j0, i1, i2);
+    i0 = f35(instance, j0, i1, i2);
     l12 = i0;
     i0 = 0u;
     l20 = i0;
@@ -2255,7 +2475,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     i0 = !(i0);
     if (i0) {goto B7;}
     i0 = l7;
-    j0 = i64_load(Z_envZ_memory, (u64)(i0 + 64));
+    j0 = i64_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     i0 = !(j0);
     if (i0) {goto B7;}
     i0 = p1;
@@ -2291,47 +2511,47 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     }
     B67:;
     i0 = l7;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 64));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     i1 = l11;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     goto L2;
     B66:;
     i0 = l7;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 64));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     i1 = l11;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     goto L2;
     B65:;
     i0 = l7;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 64));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     i1 = l11;
     j1 = (u64)(s64)(s32)(i1);
-    i64_store(Z_envZ_memory, (u64)(i0), j1);
+    i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
     goto L2;
     B64:;
     i0 = l7;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 64));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     i1 = l11;
-    i32_store16(Z_envZ_memory, (u64)(i0), i1);
+    i32_store16(instance->Z_envZ_memory, (u64)(i0), i1);
     goto L2;
     B63:;
     i0 = l7;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 64));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     i1 = l11;
-    i32_store8(Z_envZ_memory, (u64)(i0), i1);
+    i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
     goto L2;
     B62:;
     i0 = l7;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 64));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     i1 = l11;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     goto L2;
     B61:;
     i0 = l7;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 64));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     i1 = l11;
     j1 = (u64)(s64)(s32)(i1);
-    i64_store(Z_envZ_memory, (u64)(i0), j1);
+    i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
     goto L2;
     B9:;
     i0 = 0u;
@@ -2339,12 +2559,12 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     i0 = 1064u;
     l16 = i0;
     i0 = l7;
-    j0 = i64_load(Z_envZ_memory, (u64)(i0 + 64));
+    j0 = i64_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     l22 = j0;
     B8:;
     j0 = l22;
     i1 = l9;
-    i0 = f36(j0, i1);
+    i0 = f36(instance, j0, i1);
     l12 = i0;
     B7:;
     i0 = l13;
@@ -2357,7 +2577,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     i0 = i2 ? i0 : i1;
     l13 = i0;
     i0 = l7;
-    j0 = i64_load(Z_envZ_memory, (u64)(i0 + 64));
+    j0 = i64_load(instance->Z_envZ_memory, (u64)(i0 + 64));
     l22 = j0;
     i0 = l19;
     if (i0) {goto B69;}
@@ -2411,11 +2631,11 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     p1 = i2;
     i3 = l14;
     i4 = l13;
-    f33(i0, i1, i2, i3, i4);
+    f33(instance, i0, i1, i2, i3, i4);
     i0 = p0;
     i1 = l16;
     i2 = l20;
-    f30(i0, i1, i2);
+    f30(instance, i0, i1, i2);
     i0 = p0;
     i1 = 48u;
     i2 = p1;
@@ -2423,17 +2643,17 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     i4 = l13;
     i5 = 65536u;
     i4 ^= i5;
-    f33(i0, i1, i2, i3, i4);
+    f33(instance, i0, i1, i2, i3, i4);
     i0 = p0;
     i1 = 48u;
     i2 = l17;
     i3 = l15;
     i4 = 0u;
-    f33(i0, i1, i2, i3, i4);
+    f33(instance, i0, i1, i2, i3, i4);
     i0 = p0;
     i1 = l12;
     i2 = l15;
-    f30(i0, i1, i2);
+    f30(instance, i0, i1, i2);
     i0 = p0;
     i1 = 32u;
     i2 = p1;
@@ -2441,7 +2661,7 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
     i4 = l13;
     i5 = 8192u;
     i4 ^= i5;
-    f33(i0, i1, i2, i3, i4);
+    f33(instance, i0, i1, i2, i3, i4);
     goto L2;
     B5:;
   i0 = 0u;
@@ -2454,51 +2674,56 @@ static u32 f29(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
   i0 = l7;
   i1 = 80u;
   i0 += i1;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = l20;
   FUNC_EPILOGUE;
   return i0;
 }
 
-static void f30(u32 p0, u32 p1, u32 p2) {
+static void f30(hello_instance_t* instance, u32 p0, u32 p1, u32 p2) {
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2;
   i0 = p0;
-  i0 = i32_load8_u(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0));
   i1 = 32u;
   i0 &= i1;
   if (i0) {goto B0;}
   i0 = p1;
   i1 = p2;
   i2 = p0;
-  i0 = f27(i0, i1, i2);
+  i0 = f27(instance, i0, i1, i2);
   B0:;
   FUNC_EPILOGUE;
 }
 
-static u32 f31(u32 p0) {
+static u32 f31(hello_instance_t* instance, u32 p0) {
   u32 l1 = 0, l2 = 0, l3 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2;
   i0 = 0u;
   l1 = i0;
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
-  i0 = i32_load8_s(Z_envZ_memory, (u64)(i0));
-  i0 = f18(i0);
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
+  i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0));
+  i0 = f18(instance, i0);
   i0 = !(i0);
   if (i0) {goto B0;}
   L1: 
+    EPOCH_CHECK;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     l2 = i0;
-    i0 = i32_load8_s(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0));
     l3 = i0;
     i0 = p0;
     i1 = l2;
     i2 = 1u;
     i1 += i2;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = l3;
     i1 = l1;
     i2 = 10u;
@@ -2508,8 +2733,8 @@ static u32 f31(u32 p0) {
     i0 += i1;
     l1 = i0;
     i0 = l2;
-    i0 = i32_load8_s(Z_envZ_memory, (u64)(i0 + 1));
-    i0 = f18(i0);
+    i0 = i32_load8_s(instance->Z_envZ_memory, (u64)(i0 + 1));
+    i0 = f18(instance, i0);
     if (i0) {goto L1;}
   B0:;
   i0 = l1;
@@ -2517,8 +2742,10 @@ static u32 f31(u32 p0) {
   return i0;
 }
 
-static void f32_0(u32 p0, u32 p1, u32 p2, u32 p3) {
+static void f32_0(hello_instance_t* instance, u32 p0, u32 p1, u32 p2, u32 p3) {
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2;
   u64 j1;
   i0 = p1;
@@ -2549,46 +2776,46 @@ static void f32_0(u32 p0, u32 p1, u32 p2, u32 p3) {
   B10:;
   i0 = p2;
   i1 = p2;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   p1 = i1;
   i2 = 4u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   goto Bfunc;
   B9:;
   i0 = p2;
   i1 = p2;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   p1 = i1;
   i2 = 4u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  j1 = i64_load32_s(Z_envZ_memory, (u64)(i1));
-  i64_store(Z_envZ_memory, (u64)(i0), j1);
+  j1 = i64_load32_s(instance->Z_envZ_memory, (u64)(i1));
+  i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
   goto Bfunc;
   B8:;
   i0 = p2;
   i1 = p2;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   p1 = i1;
   i2 = 4u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  j1 = i64_load32_u(Z_envZ_memory, (u64)(i1));
-  i64_store(Z_envZ_memory, (u64)(i0), j1);
+  j1 = i64_load32_u(instance->Z_envZ_memory, (u64)(i1));
+  i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
   goto Bfunc;
   B7:;
   i0 = p2;
   i1 = p2;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   i2 = 7u;
   i1 += i2;
   i2 = 4294967288u;
@@ -2596,68 +2823,68 @@ static void f32_0(u32 p0, u32 p1, u32 p2, u32 p3) {
   p1 = i1;
   i2 = 8u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  j1 = i64_load(Z_envZ_memory, (u64)(i1));
-  i64_store(Z_envZ_memory, (u64)(i0), j1);
+  j1 = i64_load(instance->Z_envZ_memory, (u64)(i1));
+  i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
   goto Bfunc;
   B6:;
   i0 = p2;
   i1 = p2;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   p1 = i1;
   i2 = 4u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  j1 = i64_load16_s(Z_envZ_memory, (u64)(i1));
-  i64_store(Z_envZ_memory, (u64)(i0), j1);
+  j1 = i64_load16_s(instance->Z_envZ_memory, (u64)(i1));
+  i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
   goto Bfunc;
   B5:;
   i0 = p2;
   i1 = p2;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   p1 = i1;
   i2 = 4u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  j1 = i32_load16_u(Z_envZ_memory, (u64)(i1));
-  i64_store(Z_envZ_memory, (u64)(i0), j1);
+  j1 = i32_load16_u(instance->Z_envZ_memory, (u64)(i1));
+  i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
   goto Bfunc;
   B4:;
   i0 = p2;
   i1 = p2;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   p1 = i1;
   i2 = 4u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  j1 = i64_load8_s(Z_envZ_memory, (u64)(i1));
-  i64_store(Z_envZ_memory, (u64)(i0), j1);
+  j1 = i64_load8_s(instance->Z_envZ_memory, (u64)(i1));
+  i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
   goto Bfunc;
   B3:;
   i0 = p2;
   i1 = p2;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   p1 = i1;
   i2 = 4u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  j1 = i64_load8_u(Z_envZ_memory, (u64)(i1));
-  i64_store(Z_envZ_memory, (u64)(i0), j1);
+  j1 = i64_load8_u(instance->Z_envZ_memory, (u64)(i1));
+  i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
   goto Bfunc;
   B2:;
   i0 = p2;
   i1 = p2;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   i2 = 7u;
   i1 += i2;
   i2 = 4294967288u;
@@ -2665,31 +2892,32 @@ static void f32_0(u32 p0, u32 p1, u32 p2, u32 p3) {
   p1 = i1;
   i2 = 8u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  j1 = i64_load(Z_envZ_memory, (u64)(i1));
-  i64_store(Z_envZ_memory, (u64)(i0), j1);
+  j1 = i64_load(instance->Z_envZ_memory, (u64)(i1));
+  i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
   goto Bfunc;
   B1:;
   i0 = p0;
   i1 = p2;
   i2 = p3;
-  CALL_INDIRECT((*Z_envZ_table), void (*)(u32, u32), 2, i2, i0, i1);
+  CALL_INDIRECT_DIRECT((*instance->Z_envZ_table), void (*)(hello_instance_t*, u32, u32), 2, i2, 5, f39, instance, i0, i1);
   B0:;
   Bfunc:;
   FUNC_EPILOGUE;
 }
 
-static void f33(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
+static void f33(hello_instance_t* instance, u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   u32 l5 = 0, l6 = 0;
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0, i1, i2, i3, i4, i5;
-  i0 = g0;
+  i0 = instance->globals.g0;
   i1 = 256u;
   i0 -= i1;
   l5 = i0;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = p2;
   i1 = p3;
   i0 = (u32)((s32)i0 <= (s32)i1);
@@ -2710,7 +2938,7 @@ static void f33(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   i4 = i4 < i5;
   l6 = i4;
   i2 = i4 ? i2 : i3;
-  i0 = f54(i0, i1, i2);
+  i0 = f54(instance, i0, i1, i2);
   i0 = l6;
   if (i0) {goto B1;}
   i0 = p2;
@@ -2718,10 +2946,11 @@ static void f33(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   i0 -= i1;
   p2 = i0;
   L2: 
+    EPOCH_CHECK;
     i0 = p0;
     i1 = l5;
     i2 = 256u;
-    f30(i0, i1, i2);
+    f30(instance, i0, i1, i2);
     i0 = p4;
     i1 = 4294967040u;
     i0 += i1;
@@ -2737,23 +2966,25 @@ static void f33(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   i0 = p0;
   i1 = l5;
   i2 = p4;
-  f30(i0, i1, i2);
+  f30(instance, i0, i1, i2);
   B0:;
   i0 = l5;
   i1 = 256u;
   i0 += i1;
-  g0 = i0;
+  instance->globals.g0 = i0;
   FUNC_EPILOGUE;
 }
 
-static u32 f34(u64 p0, u32 p1) {
-  FUNC_PROLOGUE;
+static u32 f34(hello_instance_t* instance, u64 p0, u32 p1) {
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1, i2;
   u64 j0, j1;
   j0 = p0;
   i0 = !(j0);
   if (i0) {goto B0;}
   L1: 
+    EPOCH_CHECK;
     i0 = p1;
     i1 = 4294967295u;
     i0 += i1;
@@ -2764,7 +2995,7 @@ static u32 f34(u64 p0, u32 p1) {
     i1 &= i2;
     i2 = 48u;
     i1 |= i2;
-    i32_store8(Z_envZ_memory, (u64)(i0), i1);
+    i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
     j0 = p0;
     j1 = 3ull;
     j0 >>= (j1 & 63);
@@ -2774,18 +3005,20 @@ static u32 f34(u64 p0, u32 p1) {
     if (i0) {goto L1;}
   B0:;
   i0 = p1;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u32 f35(u64 p0, u32 p1, u32 p2) {
-  FUNC_PROLOGUE;
+static u32 f35(hello_instance_t* instance, u64 p0, u32 p1, u32 p2) {
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1, i2;
   u64 j0, j1;
   j0 = p0;
   i0 = !(j0);
   if (i0) {goto B0;}
   L1: 
+    EPOCH_CHECK;
     i0 = p1;
     i1 = 4294967295u;
     i0 += i1;
@@ -2796,10 +3029,10 @@ static u32 f35(u64 p0, u32 p1, u32 p2) {
     i1 &= i2;
     i2 = 1552u;
     i1 += i2;
-    i1 = i32_load8_u(Z_envZ_memory, (u64)(i1));
+    i1 = i32_load8_u(instance->Z_envZ_memory, (u64)(i1));
     i2 = p2;
     i1 |= i2;
-    i32_store8(Z_envZ_memory, (u64)(i0), i1);
+    i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
     j0 = p0;
     j1 = 4ull;
     j0 >>= (j1 & 63);
@@ -2809,14 +3042,15 @@ static u32 f35(u64 p0, u32 p1, u32 p2) {
     if (i0) {goto L1;}
   B0:;
   i0 = p1;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u32 f36(u64 p0, u32 p1) {
+static u32 f36(hello_instance_t* instance, u64 p0, u32 p1) {
   u32 l2 = 0, l3 = 0, l4 = 0;
   u64 l5 = 0;
-  FUNC_PROLOGUE;
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1, i2, i3;
   u64 j0, j1, j2, j3;
   j0 = p0;
@@ -2828,6 +3062,7 @@ static u32 f36(u64 p0, u32 p1) {
   goto B0;
   B1:;
   L2: 
+    EPOCH_CHECK;
     i0 = p1;
     i1 = 4294967295u;
     i0 += i1;
@@ -2843,7 +3078,7 @@ static u32 f36(u64 p0, u32 p1) {
     i1 = (u32)(j1);
     i2 = 48u;
     i1 |= i2;
-    i32_store8(Z_envZ_memory, (u64)(i0), i1);
+    i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
     j0 = p0;
     j1 = 42949672959ull;
     i0 = j0 > j1;
@@ -2859,6 +3094,7 @@ static u32 f36(u64 p0, u32 p1) {
   i0 = !(i0);
   if (i0) {goto B3;}
   L4: 
+    EPOCH_CHECK;
     i0 = p1;
     i1 = 4294967295u;
     i0 += i1;
@@ -2873,7 +3109,7 @@ static u32 f36(u64 p0, u32 p1) {
     i1 -= i2;
     i2 = 48u;
     i1 |= i2;
-    i32_store8(Z_envZ_memory, (u64)(i0), i1);
+    i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = l2;
     i1 = 9u;
     i0 = i0 > i1;
@@ -2884,42 +3120,45 @@ static u32 f36(u64 p0, u32 p1) {
     if (i0) {goto L4;}
   B3:;
   i0 = p1;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u32 f37(u32 p0, u32 p1, u32 p2) {
+static u32 f37(hello_instance_t* instance, u32 p0, u32 p1, u32 p2) {
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0, i1, i2, i3, i4;
   i0 = p0;
   i1 = p1;
   i2 = p2;
   i3 = 4u;
   i4 = 5u;
-  i0 = f28(i0, i1, i2, i3, i4);
+  i0 = f28(instance, i0, i1, i2, i3, i4);
   FUNC_EPILOGUE;
   return i0;
 }
 
-static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
+static u32 f38(hello_instance_t* instance, u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   u32 l6 = 0, l7 = 0, l8 = 0, l9 = 0, l10 = 0, l11 = 0, l12 = 0, l13 = 0, 
       l14 = 0, l15 = 0, l16 = 0, l17 = 0, l18 = 0, l19 = 0, l20 = 0, l21 = 0;
   u64 l22 = 0, l23 = 0;
   f64 l24 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2, i3, i4, i5;
   u64 j0, j1, j2, j3;
   f64 d0, d1, d2, d3, d4;
-  i0 = g0;
+  i0 = instance->globals.g0;
   i1 = 560u;
   i0 -= i1;
   l6 = i0;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = l6;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 44), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 44), i1);
   d0 = p1;
-  j0 = f40(d0);
+  j0 = f40(instance, d0);
   l22 = j0;
   j1 = 18446744073709551615ull;
   i0 = (u64)((s64)j0 > (s64)j1);
@@ -2927,7 +3166,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   d0 = p1;
   d0 = -(d0);
   p1 = d0;
-  j0 = f40(d0);
+  j0 = f40(instance, d0);
   l22 = j0;
   i0 = 1u;
   l7 = i0;
@@ -2971,11 +3210,11 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i4 = p4;
   i5 = 4294901759u;
   i4 &= i5;
-  f33(i0, i1, i2, i3, i4);
+  f33(instance, i0, i1, i2, i3, i4);
   i0 = p0;
   i1 = l8;
   i2 = l7;
-  f30(i0, i1, i2);
+  f30(instance, i0, i1, i2);
   i0 = p0;
   i1 = 1595u;
   i2 = 1599u;
@@ -2995,7 +3234,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i3 = d3 != d4;
   i1 = i3 ? i1 : i2;
   i2 = 3u;
-  f30(i0, i1, i2);
+  f30(instance, i0, i1, i2);
   i0 = p0;
   i1 = 32u;
   i2 = p2;
@@ -3003,14 +3242,14 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i4 = p4;
   i5 = 8192u;
   i4 ^= i5;
-  f33(i0, i1, i2, i3, i4);
+  f33(instance, i0, i1, i2, i3, i4);
   goto B3;
   B4:;
   d0 = p1;
   i1 = l6;
   i2 = 44u;
   i1 += i2;
-  d0 = f23(d0, i1);
+  d0 = f23(instance, d0, i1);
   p1 = d0;
   d1 = p1;
   d0 += d1;
@@ -3020,10 +3259,10 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   if (i0) {goto B5;}
   i0 = l6;
   i1 = l6;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 44));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 44));
   i2 = 4294967295u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 44), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 44), i1);
   B5:;
   i0 = l6;
   i1 = 16u;
@@ -3059,6 +3298,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   d0 = 8;
   l24 = d0;
   L8: 
+    EPOCH_CHECK;
     d0 = l24;
     d1 = 16;
     d0 *= d1;
@@ -3069,7 +3309,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     l10 = i0;
     if (i0) {goto L8;}
   i0 = l14;
-  i0 = i32_load8_u(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0));
   i1 = 45u;
   i0 = i0 != i1;
   if (i0) {goto B9;}
@@ -3091,7 +3331,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   p1 = d0;
   B7:;
   i0 = l6;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 44));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 44));
   l10 = i0;
   i1 = l10;
   i2 = 31u;
@@ -3102,14 +3342,14 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 ^= i1;
   j0 = (u64)(i0);
   i1 = l11;
-  i0 = f36(j0, i1);
+  i0 = f36(instance, j0, i1);
   l10 = i0;
   i1 = l11;
   i0 = i0 != i1;
   if (i0) {goto B10;}
   i0 = l6;
   i1 = 48u;
-  i32_store8(Z_envZ_memory, (u64)(i0 + 15), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0 + 15), i1);
   i0 = l6;
   i1 = 15u;
   i0 += i1;
@@ -3120,7 +3360,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 |= i1;
   l15 = i0;
   i0 = l6;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 44));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 44));
   l16 = i0;
   i0 = l10;
   i1 = 4294967294u;
@@ -3129,7 +3369,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i1 = p5;
   i2 = 15u;
   i1 += i2;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l10;
   i1 = 4294967295u;
   i0 += i1;
@@ -3139,7 +3379,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i4 = 0u;
   i3 = (u32)((s32)i3 < (s32)i4);
   i1 = i3 ? i1 : i2;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p4;
   i1 = 8u;
   i0 &= i1;
@@ -3149,6 +3389,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 += i1;
   l16 = i0;
   L11: 
+    EPOCH_CHECK;
     i0 = l16;
     l10 = i0;
     d0 = p1;
@@ -3169,10 +3410,10 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i1 = l16;
     i2 = 1552u;
     i1 += i2;
-    i1 = i32_load8_u(Z_envZ_memory, (u64)(i1));
+    i1 = i32_load8_u(instance->Z_envZ_memory, (u64)(i1));
     i2 = l13;
     i1 |= i2;
-    i32_store8(Z_envZ_memory, (u64)(i0), i1);
+    i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
     d0 = p1;
     i1 = l16;
     d1 = (f64)(s32)(i1);
@@ -3204,7 +3445,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     B15:;
     i0 = l10;
     i1 = 46u;
-    i32_store8(Z_envZ_memory, (u64)(i0 + 1), i1);
+    i32_store8(instance->Z_envZ_memory, (u64)(i0 + 1), i1);
     i0 = l10;
     i1 = 2u;
     i0 += i1;
@@ -3256,11 +3497,11 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i3 += i4;
   l9 = i3;
   i4 = p4;
-  f33(i0, i1, i2, i3, i4);
+  f33(instance, i0, i1, i2, i3, i4);
   i0 = p0;
   i1 = l14;
   i2 = l15;
-  f30(i0, i1, i2);
+  f30(instance, i0, i1, i2);
   i0 = p0;
   i1 = 48u;
   i2 = p2;
@@ -3268,7 +3509,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i4 = p4;
   i5 = 65536u;
   i4 ^= i5;
-  f33(i0, i1, i2, i3, i4);
+  f33(instance, i0, i1, i2, i3, i4);
   i0 = p0;
   i1 = l6;
   i2 = 16u;
@@ -3279,7 +3520,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i3 += i4;
   i2 -= i3;
   l16 = i2;
-  f30(i0, i1, i2);
+  f30(instance, i0, i1, i2);
   i0 = p0;
   i1 = 48u;
   i2 = l10;
@@ -3292,11 +3533,11 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i2 -= i3;
   i3 = 0u;
   i4 = 0u;
-  f33(i0, i1, i2, i3, i4);
+  f33(instance, i0, i1, i2, i3, i4);
   i0 = p0;
   i1 = l17;
   i2 = l13;
-  f30(i0, i1, i2);
+  f30(instance, i0, i1, i2);
   i0 = p0;
   i1 = 32u;
   i2 = p2;
@@ -3304,7 +3545,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i4 = p4;
   i5 = 8192u;
   i4 ^= i5;
-  f33(i0, i1, i2, i3, i4);
+  f33(instance, i0, i1, i2, i3, i4);
   goto B3;
   B6:;
   i0 = p3;
@@ -3316,17 +3557,17 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 = d0 != d1;
   if (i0) {goto B19;}
   i0 = l6;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 44));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 44));
   l18 = i0;
   goto B18;
   B19:;
   i0 = l6;
   i1 = l6;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 44));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 44));
   i2 = 4294967268u;
   i1 += i2;
   l18 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 44), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 44), i1);
   d0 = p1;
   d1 = 268435456;
   d0 *= d1;
@@ -3350,6 +3591,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   l19 = i0;
   l13 = i0;
   L20: 
+    EPOCH_CHECK;
     d0 = p1;
     d1 = 4294967296;
     i0 = d0 < d1;
@@ -3369,7 +3611,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     B21:;
     i0 = l13;
     i1 = l10;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = l13;
     i1 = 4u;
     i0 += i1;
@@ -3397,6 +3639,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 = l19;
   l16 = i0;
   L25: 
+    EPOCH_CHECK;
     i0 = l18;
     i1 = 29u;
     i2 = l18;
@@ -3417,9 +3660,10 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     j0 = 0ull;
     l22 = j0;
     L27: 
+      EPOCH_CHECK;
       i0 = l10;
       i1 = l10;
-      j1 = i64_load32_u(Z_envZ_memory, (u64)(i1));
+      j1 = i64_load32_u(instance->Z_envZ_memory, (u64)(i1));
       j2 = l23;
       j1 <<= (j2 & 63);
       j2 = l22;
@@ -3434,7 +3678,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
       j3 = 1000000000ull;
       j2 *= j3;
       j1 -= j2;
-      i64_store32(Z_envZ_memory, (u64)(i0), j1);
+      i64_store32(instance->Z_envZ_memory, (u64)(i0), j1);
       i0 = l10;
       i1 = 4294967292u;
       i0 += i1;
@@ -3452,9 +3696,10 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i0 += i1;
     l16 = i0;
     i1 = l10;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     B26:;
     L29: 
+      EPOCH_CHECK;
       i0 = l13;
       l10 = i0;
       i1 = l16;
@@ -3464,17 +3709,17 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
       i1 = 4294967292u;
       i0 += i1;
       l13 = i0;
-      i0 = i32_load(Z_envZ_memory, (u64)(i0));
+      i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
       i0 = !(i0);
       if (i0) {goto L29;}
     B28:;
     i0 = l6;
     i1 = l6;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 44));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 44));
     i2 = l18;
     i1 -= i2;
     l18 = i1;
-    i32_store(Z_envZ_memory, (u64)(i0 + 44), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 44), i1);
     i0 = l10;
     l13 = i0;
     i0 = l18;
@@ -3499,6 +3744,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 = i0 == i1;
   l21 = i0;
   L31: 
+    EPOCH_CHECK;
     i0 = 9u;
     i1 = 0u;
     i2 = l18;
@@ -3517,7 +3763,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i2 = 4u;
     i1 += i2;
     i2 = l16;
-    i2 = i32_load(Z_envZ_memory, (u64)(i2));
+    i2 = i32_load(instance->Z_envZ_memory, (u64)(i2));
     i0 = i2 ? i0 : i1;
     l16 = i0;
     goto B32;
@@ -3537,15 +3783,16 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i0 = l16;
     l13 = i0;
     L34: 
+      EPOCH_CHECK;
       i0 = l13;
       i1 = l13;
-      i1 = i32_load(Z_envZ_memory, (u64)(i1));
+      i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
       p3 = i1;
       i2 = l9;
       i1 >>= (i2 & 31);
       i2 = l18;
       i1 += i2;
-      i32_store(Z_envZ_memory, (u64)(i0), i1);
+      i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
       i0 = p3;
       i1 = l15;
       i0 &= i1;
@@ -3564,7 +3811,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i2 = 4u;
     i1 += i2;
     i2 = l16;
-    i2 = i32_load(Z_envZ_memory, (u64)(i2));
+    i2 = i32_load(instance->Z_envZ_memory, (u64)(i2));
     i0 = i2 ? i0 : i1;
     l16 = i0;
     i0 = l18;
@@ -3572,7 +3819,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     if (i0) {goto B32;}
     i0 = l10;
     i1 = l18;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = l10;
     i1 = 4u;
     i0 += i1;
@@ -3580,11 +3827,11 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     B32:;
     i0 = l6;
     i1 = l6;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 44));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 44));
     i2 = l9;
     i1 += i2;
     l18 = i1;
-    i32_store(Z_envZ_memory, (u64)(i0 + 44), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 44), i1);
     i0 = l19;
     i1 = l16;
     i2 = l21;
@@ -3626,12 +3873,13 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 = 10u;
   l18 = i0;
   i0 = l16;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   p3 = i0;
   i1 = 10u;
   i0 = i0 < i1;
   if (i0) {goto B35;}
   L36: 
+    EPOCH_CHECK;
     i0 = l13;
     i1 = 1u;
     i0 += i1;
@@ -3700,6 +3948,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 = (u32)((s32)i0 > (s32)i1);
   if (i0) {goto B38;}
   L39: 
+    EPOCH_CHECK;
     i0 = l18;
     i1 = 10u;
     i0 *= i1;
@@ -3713,7 +3962,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     if (i0) {goto L39;}
   B38:;
   i0 = l9;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l17 = i0;
   i1 = l17;
   i2 = l18;
@@ -3765,7 +4014,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 = !(i0);
   if (i0) {goto B42;}
   i0 = l8;
-  i0 = i32_load8_u(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0));
   i1 = 45u;
   i0 = i0 != i1;
   if (i0) {goto B42;}
@@ -3781,7 +4030,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i2 = p3;
   i1 -= i2;
   p3 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   d0 = p1;
   d1 = l24;
   d0 += d1;
@@ -3793,15 +4042,16 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i2 = l18;
   i1 += i2;
   l13 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l13;
   i1 = 1000000000u;
   i0 = i0 < i1;
   if (i0) {goto B43;}
   L44: 
+    EPOCH_CHECK;
     i0 = l9;
     i1 = 0u;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = l9;
     i1 = 4294967292u;
     i0 += i1;
@@ -3814,15 +4064,15 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i0 += i1;
     l16 = i0;
     i1 = 0u;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     B45:;
     i0 = l9;
     i1 = l9;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
     i2 = 1u;
     i1 += i2;
     l13 = i1;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = l13;
     i1 = 999999999u;
     i0 = i0 > i1;
@@ -3839,12 +4089,13 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 = 10u;
   l18 = i0;
   i0 = l16;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   p3 = i0;
   i1 = 10u;
   i0 = i0 < i1;
   if (i0) {goto B40;}
   L46: 
+    EPOCH_CHECK;
     i0 = l13;
     i1 = 1u;
     i0 += i1;
@@ -3869,6 +4120,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   l10 = i0;
   B37:;
   L48: 
+    EPOCH_CHECK;
     i0 = l10;
     l18 = i0;
     i1 = l16;
@@ -3882,7 +4134,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i1 = 4294967292u;
     i0 += i1;
     l10 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     i0 = !(i0);
     if (i0) {goto L48;}
   i0 = 1u;
@@ -3940,7 +4192,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 = l18;
   i1 = 4294967292u;
   i0 += i1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l9 = i0;
   i0 = !(i0);
   if (i0) {goto B52;}
@@ -3953,6 +4205,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 = REM_U(i0, i1);
   if (i0) {goto B52;}
   L53: 
+    EPOCH_CHECK;
     i0 = l10;
     i1 = 1u;
     i0 += i1;
@@ -4057,19 +4310,20 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i1 ^= i2;
   j1 = (u64)(i1);
   i2 = l11;
-  i1 = f36(j1, i2);
+  i1 = f36(instance, j1, i2);
   l10 = i1;
   i0 -= i1;
   i1 = 1u;
   i0 = (u32)((s32)i0 > (s32)i1);
   if (i0) {goto B57;}
   L58: 
+    EPOCH_CHECK;
     i0 = l10;
     i1 = 4294967295u;
     i0 += i1;
     l10 = i0;
     i1 = 48u;
-    i32_store8(Z_envZ_memory, (u64)(i0), i1);
+    i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = l11;
     i1 = l10;
     i0 -= i1;
@@ -4082,7 +4336,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 += i1;
   l20 = i0;
   i1 = p5;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l10;
   i1 = 4294967295u;
   i0 += i1;
@@ -4092,7 +4346,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i4 = 0u;
   i3 = (u32)((s32)i3 < (s32)i4);
   i1 = i3 ? i1 : i2;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l11;
   i1 = l20;
   i0 -= i1;
@@ -4112,11 +4366,11 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i3 += i4;
   l9 = i3;
   i4 = p4;
-  f33(i0, i1, i2, i3, i4);
+  f33(instance, i0, i1, i2, i3, i4);
   i0 = p0;
   i1 = l8;
   i2 = l7;
-  f30(i0, i1, i2);
+  f30(instance, i0, i1, i2);
   i0 = p0;
   i1 = 48u;
   i2 = p2;
@@ -4124,7 +4378,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i4 = p4;
   i5 = 65536u;
   i4 ^= i5;
-  f33(i0, i1, i2, i3, i4);
+  f33(instance, i0, i1, i2, i3, i4);
   i0 = l17;
   i1 = 102u;
   i0 = i0 != i1;
@@ -4150,10 +4404,11 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   p3 = i0;
   l16 = i0;
   L61: 
+    EPOCH_CHECK;
     i0 = l16;
-    j0 = i64_load32_u(Z_envZ_memory, (u64)(i0));
+    j0 = i64_load32_u(instance->Z_envZ_memory, (u64)(i0));
     i1 = l13;
-    i0 = f36(j0, i1);
+    i0 = f36(instance, j0, i1);
     l10 = i0;
     i0 = l16;
     i1 = p3;
@@ -4166,12 +4421,13 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i0 = i0 <= i1;
     if (i0) {goto B62;}
     L64: 
+      EPOCH_CHECK;
       i0 = l10;
       i1 = 4294967295u;
       i0 += i1;
       l10 = i0;
       i1 = 48u;
-      i32_store8(Z_envZ_memory, (u64)(i0), i1);
+      i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
       i0 = l10;
       i1 = l6;
       i2 = 16u;
@@ -4187,7 +4443,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     if (i0) {goto B62;}
     i0 = l6;
     i1 = 48u;
-    i32_store8(Z_envZ_memory, (u64)(i0 + 24), i1);
+    i32_store8(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
     i0 = l17;
     l10 = i0;
     B62:;
@@ -4196,7 +4452,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i2 = l13;
     i3 = l10;
     i2 -= i3;
-    f30(i0, i1, i2);
+    f30(instance, i0, i1, i2);
     i0 = l16;
     i1 = 4u;
     i0 += i1;
@@ -4210,7 +4466,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 = p0;
   i1 = 1603u;
   i2 = 1u;
-  f30(i0, i1, i2);
+  f30(instance, i0, i1, i2);
   B65:;
   i0 = l16;
   i1 = l18;
@@ -4221,10 +4477,11 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 = (u32)((s32)i0 < (s32)i1);
   if (i0) {goto B66;}
   L67: 
+    EPOCH_CHECK;
     i0 = l16;
-    j0 = i64_load32_u(Z_envZ_memory, (u64)(i0));
+    j0 = i64_load32_u(instance->Z_envZ_memory, (u64)(i0));
     i1 = l13;
-    i0 = f36(j0, i1);
+    i0 = f36(instance, j0, i1);
     l10 = i0;
     i1 = l6;
     i2 = 16u;
@@ -4232,12 +4489,13 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i0 = i0 <= i1;
     if (i0) {goto B68;}
     L69: 
+      EPOCH_CHECK;
       i0 = l10;
       i1 = 4294967295u;
       i0 += i1;
       l10 = i0;
       i1 = 48u;
-      i32_store8(Z_envZ_memory, (u64)(i0), i1);
+      i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
       i0 = l10;
       i1 = l6;
       i2 = 16u;
@@ -4253,7 +4511,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i5 = 9u;
     i4 = (u32)((s32)i4 < (s32)i5);
     i2 = i4 ? i2 : i3;
-    f30(i0, i1, i2);
+    f30(instance, i0, i1, i2);
     i0 = l14;
     i1 = 4294967287u;
     i0 += i1;
@@ -4277,7 +4535,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i2 += i3;
   i3 = 9u;
   i4 = 0u;
-  f33(i0, i1, i2, i3, i4);
+  f33(instance, i0, i1, i2, i3, i4);
   goto B59;
   B60:;
   i0 = l14;
@@ -4306,17 +4564,18 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i0 = l16;
   l13 = i0;
   L71: 
+    EPOCH_CHECK;
     i0 = l13;
-    j0 = i64_load32_u(Z_envZ_memory, (u64)(i0));
+    j0 = i64_load32_u(instance->Z_envZ_memory, (u64)(i0));
     i1 = l18;
-    i0 = f36(j0, i1);
+    i0 = f36(instance, j0, i1);
     l10 = i0;
     i1 = l18;
     i0 = i0 != i1;
     if (i0) {goto B72;}
     i0 = l6;
     i1 = 48u;
-    i32_store8(Z_envZ_memory, (u64)(i0 + 24), i1);
+    i32_store8(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
     i0 = l19;
     l10 = i0;
     B72:;
@@ -4331,12 +4590,13 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i0 = i0 <= i1;
     if (i0) {goto B73;}
     L75: 
+      EPOCH_CHECK;
       i0 = l10;
       i1 = 4294967295u;
       i0 += i1;
       l10 = i0;
       i1 = 48u;
-      i32_store8(Z_envZ_memory, (u64)(i0), i1);
+      i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
       i0 = l10;
       i1 = l6;
       i2 = 16u;
@@ -4349,7 +4609,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i0 = p0;
     i1 = l10;
     i2 = 1u;
-    f30(i0, i1, i2);
+    f30(instance, i0, i1, i2);
     i0 = l10;
     i1 = 1u;
     i0 += i1;
@@ -4364,7 +4624,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i0 = p0;
     i1 = 1603u;
     i2 = 1u;
-    f30(i0, i1, i2);
+    f30(instance, i0, i1, i2);
     B73:;
     i0 = p0;
     i1 = l10;
@@ -4377,7 +4637,7 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
     i5 = p3;
     i4 = (u32)((s32)i4 > (s32)i5);
     i2 = i4 ? i2 : i3;
-    f30(i0, i1, i2);
+    f30(instance, i0, i1, i2);
     i0 = l14;
     i1 = p3;
     i0 -= i1;
@@ -4401,13 +4661,13 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i2 += i3;
   i3 = 18u;
   i4 = 0u;
-  f33(i0, i1, i2, i3, i4);
+  f33(instance, i0, i1, i2, i3, i4);
   i0 = p0;
   i1 = l20;
   i2 = l11;
   i3 = l20;
   i2 -= i3;
-  f30(i0, i1, i2);
+  f30(instance, i0, i1, i2);
   B59:;
   i0 = p0;
   i1 = 32u;
@@ -4416,12 +4676,12 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   i4 = p4;
   i5 = 8192u;
   i4 ^= i5;
-  f33(i0, i1, i2, i3, i4);
+  f33(instance, i0, i1, i2, i3, i4);
   B3:;
   i0 = l6;
   i1 = 560u;
   i0 += i1;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = p2;
   i1 = l9;
   i2 = l9;
@@ -4432,15 +4692,17 @@ static u32 f38(u32 p0, f64 p1, u32 p2, u32 p3, u32 p4, u32 p5) {
   return i0;
 }
 
-static void f39(u32 p0, u32 p1) {
+static void f39(hello_instance_t* instance, u32 p0, u32 p1) {
   u32 l2 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2;
   u64 j1, j2;
   f64 d1;
   i0 = p1;
   i1 = p1;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   i2 = 15u;
   i1 += i2;
   i2 = 4294967280u;
@@ -4448,30 +4710,31 @@ static void f39(u32 p0, u32 p1) {
   l2 = i1;
   i2 = 16u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = l2;
-  j1 = i64_load(Z_envZ_memory, (u64)(i1));
+  j1 = i64_load(instance->Z_envZ_memory, (u64)(i1));
   i2 = l2;
-  j2 = i64_load(Z_envZ_memory, (u64)(i2 + 8));
-  d1 = f49(j1, j2);
-  f64_store(Z_envZ_memory, (u64)(i0), d1);
+  j2 = i64_load(instance->Z_envZ_memory, (u64)(i2 + 8));
+  d1 = f49(instance, j1, j2);
+  f64_store(instance->Z_envZ_memory, (u64)(i0), d1);
   FUNC_EPILOGUE;
 }
 
-static u64 f40(f64 p0) {
-  FUNC_PROLOGUE;
+static u64 f40(hello_instance_t* instance, f64 p0) {
+  LEAF_PROLOGUE;
   u64 j0;
   f64 d0;
   d0 = p0;
   j0 = i64_reinterpret_f64(d0);
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return j0;
 }
 
-static u32 f41(u32 p0, u32 p1, u32 p2) {
+static u32 f41(hello_instance_t* instance, u32 p0, u32 p1, u32 p2) {
   u32 l3 = 0, l4 = 0, l5 = 0, l6 = 0;
-  FUNC_PROLOGUE;
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1, i2;
   i0 = p2;
   i1 = 0u;
@@ -4490,8 +4753,9 @@ static u32 f41(u32 p0, u32 p1, u32 p2) {
   i0 &= i1;
   l4 = i0;
   L4: 
+    EPOCH_CHECK;
     i0 = p0;
-    i0 = i32_load8_u(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0));
     i1 = l4;
     i0 = i0 == i1;
     if (i0) {goto B2;}
@@ -4519,7 +4783,7 @@ static u32 f41(u32 p0, u32 p1, u32 p2) {
   if (i0) {goto B1;}
   B2:;
   i0 = p0;
-  i0 = i32_load8_u(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0));
   i1 = p1;
   i2 = 255u;
   i1 &= i2;
@@ -4552,8 +4816,9 @@ static u32 f41(u32 p0, u32 p1, u32 p2) {
   i0 += i1;
   l6 = i0;
   L7: 
+    EPOCH_CHECK;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     i1 = l4;
     i0 ^= i1;
     l3 = i0;
@@ -4591,8 +4856,9 @@ static u32 f41(u32 p0, u32 p1, u32 p2) {
   i0 &= i1;
   l3 = i0;
   L8: 
+    EPOCH_CHECK;
     i0 = p0;
-    i0 = i32_load8_u(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0));
     i1 = l3;
     i0 = i0 == i1;
     if (i0) {goto B0;}
@@ -4611,27 +4877,29 @@ static u32 f41(u32 p0, u32 p1, u32 p2) {
   B0:;
   i0 = p0;
   Bfunc:;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u32 f42(u32 p0, u32 p1) {
+static u32 f42(hello_instance_t* instance, u32 p0, u32 p1) {
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0, i1;
   i0 = p0;
   i1 = p0;
-  i1 = f45(i1);
+  i1 = f45(instance, i1);
   i0 += i1;
   i1 = p1;
-  i0 = f44(i0, i1);
+  i0 = f44(instance, i0, i1);
   i0 = p0;
   FUNC_EPILOGUE;
   return i0;
 }
 
-static u32 f43(u32 p0, u32 p1) {
+static u32 f43(hello_instance_t* instance, u32 p0, u32 p1) {
   u32 l2 = 0;
-  FUNC_PROLOGUE;
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1, i2;
   i0 = p1;
   i1 = p0;
@@ -4645,11 +4913,12 @@ static u32 f43(u32 p0, u32 p1) {
   i0 = !(i0);
   if (i0) {goto B2;}
   L3: 
+    EPOCH_CHECK;
     i0 = p0;
     i1 = p1;
-    i1 = i32_load8_u(Z_envZ_memory, (u64)(i1));
+    i1 = i32_load8_u(instance->Z_envZ_memory, (u64)(i1));
     l2 = i1;
-    i32_store8(Z_envZ_memory, (u64)(i0), i1);
+    i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = l2;
     i0 = !(i0);
     if (i0) {goto B0;}
@@ -4666,7 +4935,7 @@ static u32 f43(u32 p0, u32 p1) {
     if (i0) {goto L3;}
   B2:;
   i0 = p1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l2 = i0;
   i1 = 4294967295u;
   i0 ^= i1;
@@ -4678,11 +4947,12 @@ static u32 f43(u32 p0, u32 p1) {
   i0 &= i1;
   if (i0) {goto B1;}
   L4: 
+    EPOCH_CHECK;
     i0 = p0;
     i1 = l2;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = p1;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
     l2 = i0;
     i0 = p0;
     i1 = 4u;
@@ -4706,18 +4976,19 @@ static u32 f43(u32 p0, u32 p1) {
   B1:;
   i0 = p0;
   i1 = p1;
-  i1 = i32_load8_u(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load8_u(instance->Z_envZ_memory, (u64)(i1));
   l2 = i1;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l2;
   i0 = !(i0);
   if (i0) {goto B0;}
   L5: 
+    EPOCH_CHECK;
     i0 = p0;
     i1 = p1;
-    i1 = i32_load8_u(Z_envZ_memory, (u64)(i1 + 1));
+    i1 = i32_load8_u(instance->Z_envZ_memory, (u64)(i1 + 1));
     l2 = i1;
-    i32_store8(Z_envZ_memory, (u64)(i0 + 1), i1);
+    i32_store8(instance->Z_envZ_memory, (u64)(i0 + 1), i1);
     i0 = p0;
     i1 = 1u;
     i0 += i1;
@@ -4730,24 +5001,26 @@ static u32 f43(u32 p0, u32 p1) {
     if (i0) {goto L5;}
   B0:;
   i0 = p0;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u32 f44(u32 p0, u32 p1) {
+static u32 f44(hello_instance_t* instance, u32 p0, u32 p1) {
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0, i1;
   i0 = p0;
   i1 = p1;
-  i0 = f43(i0, i1);
+  i0 = f43(instance, i0, i1);
   i0 = p0;
   FUNC_EPILOGUE;
   return i0;
 }
 
-static u32 f45(u32 p0) {
+static u32 f45(hello_instance_t* instance, u32 p0) {
   u32 l1 = 0, l2 = 0, l3 = 0;
-  FUNC_PROLOGUE;
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1, i2;
   i0 = p0;
   l1 = i0;
@@ -4757,7 +5030,7 @@ static u32 f45(u32 p0) {
   i0 = !(i0);
   if (i0) {goto B1;}
   i0 = p0;
-  i0 = i32_load8_u(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0));
   if (i0) {goto B2;}
   i0 = p0;
   l1 = i0;
@@ -4766,6 +5039,7 @@ static u32 f45(u32 p0) {
   i0 = p0;
   l1 = i0;
   L3: 
+    EPOCH_CHECK;
     i0 = l1;
     i1 = 1u;
     i0 += i1;
@@ -4775,20 +5049,21 @@ static u32 f45(u32 p0) {
     i0 = !(i0);
     if (i0) {goto B1;}
     i0 = l1;
-    i0 = i32_load8_u(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0));
     i0 = !(i0);
     if (i0) {goto B0;}
     goto L3;
   UNREACHABLE;
   B1:;
   L4: 
+    EPOCH_CHECK;
     i0 = l1;
     l2 = i0;
     i1 = 4u;
     i0 += i1;
     l1 = i0;
     i0 = l2;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     l3 = i0;
     i1 = 4294967295u;
     i0 ^= i1;
@@ -4809,8 +5084,9 @@ static u32 f45(u32 p0) {
   goto B0;
   B5:;
   L6: 
+    EPOCH_CHECK;
     i0 = l2;
-    i0 = i32_load8_u(Z_envZ_memory, (u64)(i0 + 1));
+    i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0 + 1));
     l3 = i0;
     i0 = l2;
     i1 = 1u;
@@ -4823,30 +5099,33 @@ static u32 f45(u32 p0) {
   i0 = l1;
   i1 = p0;
   i0 -= i1;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u32 f46(u32 p0) {
+static u32 f46(hello_instance_t* instance, u32 p0) {
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1;
   i0 = p0;
   if (i0) {goto B0;}
   i0 = 0u;
   goto Bfunc;
   B0:;
-  i0 = __errno_location();
+  i0 = __errno_location(instance);
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = 4294967295u;
   Bfunc:;
   FUNC_EPILOGUE;
   return i0;
 }
 
-static void f47(u32 p0, u64 p1, u64 p2, u32 p3) {
+static void f47(hello_instance_t* instance, u32 p0, u64 p1, u64 p2, u32 p3) {
   u64 l4 = 0;
-  FUNC_PROLOGUE;
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1, i2;
   u64 j0, j1, j2;
   i0 = p3;
@@ -4897,16 +5176,17 @@ static void f47(u32 p0, u64 p1, u64 p2, u32 p3) {
   B0:;
   i0 = p0;
   j1 = p1;
-  i64_store(Z_envZ_memory, (u64)(i0), j1);
+  i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
   i0 = p0;
   j1 = p2;
-  i64_store(Z_envZ_memory, (u64)(i0 + 8), j1);
-  FUNC_EPILOGUE;
+  i64_store(instance->Z_envZ_memory, (u64)(i0 + 8), j1);
+  LEAF_EPILOGUE;
 }
 
-static void f48(u32 p0, u64 p1, u64 p2, u32 p3) {
+static void f48(hello_instance_t* instance, u32 p0, u64 p1, u64 p2, u32 p3) {
   u64 l4 = 0;
-  FUNC_PROLOGUE;
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1, i2;
   u64 j0, j1, j2;
   i0 = p3;
@@ -4953,25 +5233,27 @@ static void f48(u32 p0, u64 p1, u64 p2, u32 p3) {
   B0:;
   i0 = p0;
   j1 = p1;
-  i64_store(Z_envZ_memory, (u64)(i0), j1);
+  i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
   i0 = p0;
   j1 = p2;
-  i64_store(Z_envZ_memory, (u64)(i0 + 8), j1);
-  FUNC_EPILOGUE;
+  i64_store(instance->Z_envZ_memory, (u64)(i0 + 8), j1);
+  LEAF_EPILOGUE;
 }
 
-static f64 f49(u64 p0, u64 p1) {
+static f64 f49(hello_instance_t* instance, u64 p0, u64 p1) {
   u32 l2 = 0, l3 = 0;
   u64 l4 = 0, l5 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2, i3, i4;
   u64 j0, j1, j2, j3;
   f64 d0;
-  i0 = g0;
+  i0 = instance->globals.g0;
   i1 = 32u;
   i0 -= i1;
   l2 = i0;
-  g0 = i0;
+  instance->globals.g0 = i0;
   j0 = p1;
   j1 = 9223372036854775807ull;
   j0 &= j1;
@@ -5073,7 +5355,7 @@ static f64 f49(u64 p0, u64 p1) {
   i3 = 15361u;
   i4 = l3;
   i3 -= i4;
-  f47(i0, j1, j2, i3);
+  f47(instance, i0, j1, j2, i3);
   i0 = l2;
   i1 = 16u;
   i0 += i1;
@@ -5082,16 +5364,16 @@ static f64 f49(u64 p0, u64 p1) {
   i3 = l3;
   i4 = 4294952063u;
   i3 += i4;
-  f48(i0, j1, j2, i3);
+  f48(instance, i0, j1, j2, i3);
   i0 = l2;
-  j0 = i64_load(Z_envZ_memory, (u64)(i0));
+  j0 = i64_load(instance->Z_envZ_memory, (u64)(i0));
   l4 = j0;
   j1 = 60ull;
   j0 >>= (j1 & 63);
   i1 = l2;
   i2 = 8u;
   i1 += i2;
-  j1 = i64_load(Z_envZ_memory, (u64)(i1));
+  j1 = i64_load(instance->Z_envZ_memory, (u64)(i1));
   j2 = 4ull;
   j1 <<= (j2 & 63);
   j0 |= j1;
@@ -5100,13 +5382,13 @@ static f64 f49(u64 p0, u64 p1) {
   j1 = 1152921504606846975ull;
   j0 &= j1;
   i1 = l2;
-  j1 = i64_load(Z_envZ_memory, (u64)(i1 + 16));
+  j1 = i64_load(instance->Z_envZ_memory, (u64)(i1 + 16));
   i2 = l2;
   i3 = 16u;
   i2 += i3;
   i3 = 8u;
   i2 += i3;
-  j2 = i64_load(Z_envZ_memory, (u64)(i2));
+  j2 = i64_load(instance->Z_envZ_memory, (u64)(i2));
   j1 |= j2;
   j2 = 0ull;
   i1 = j1 != j2;
@@ -5138,7 +5420,7 @@ static f64 f49(u64 p0, u64 p1) {
   i0 = l2;
   i1 = 32u;
   i0 += i1;
-  g0 = i0;
+  instance->globals.g0 = i0;
   j0 = l5;
   j1 = p1;
   j2 = 9223372036854775808ull;
@@ -5149,23 +5431,39 @@ static f64 f49(u64 p0, u64 p1) {
   return d0;
 }
 
-static u32 malloc(u32 p0) {
+#if HELLO_ARENA_MALLOC
+/* The embedder's allocator; dlmalloc below, and the sbrk (f52) it grows
+ * the heap with, are left unused. */
+static u32 malloc(hello_instance_t* instance, u32 p0) {
+  FUNC_PROLOGUE;
+  u32 result = (*Z_envZ_mallocZ_ii)(instance, p0);
+  FUNC_EPILOGUE;
+  return result;
+}
+#else
+static u32 malloc(hello_instance_t* instance, u32 p0) {
   u32 l1 = 0, l2 = 0, l3 = 0, l4 = 0, l5 = 0, l6 = 0, l7 = 0, l8 = 0, 
       l9 = 0, l10 = 0, l11 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2, i3, i4, i5;
   u64 j1;
-  i0 = g0;
+  i0 = instance->globals.g0;
   i1 = 16u;
   i0 -= i1;
   l1 = i0;
-  g0 = i0;
+  /* The frame is never written; only its address seeds mparams.magic. The
+   * callees (sbrk, __errno_location) use no stack, so g0 need not move. */
+#if !HELLO_PROMOTE_SLOTS
+  instance->globals.g0 = i0;
+#endif
   i0 = p0;
   i1 = 244u;
   i0 = i0 > i1;
   if (i0) {goto B11;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3112));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3112));
   l2 = i0;
   i1 = 16u;
   i2 = p0;
@@ -5200,13 +5498,13 @@ static u32 malloc(u32 p0) {
   l5 = i0;
   i1 = 3160u;
   i0 += i1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l4 = i0;
   i1 = 8u;
   i0 += i1;
   p0 = i0;
   i0 = l4;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   l6 = i0;
   i1 = l5;
   i2 = 3152u;
@@ -5220,19 +5518,19 @@ static u32 malloc(u32 p0) {
   i3 = l3;
   i2 = I32_ROTL(i2, i3);
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3112), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3112), i1);
   goto B13;
   B14:;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3128));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3128));
   i1 = l6;
   i0 = i0 > i1;
   i0 = l6;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l5;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   B13:;
   i0 = l4;
   i1 = l3;
@@ -5241,21 +5539,21 @@ static u32 malloc(u32 p0) {
   l6 = i1;
   i2 = 3u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l4;
   i1 = l6;
   i0 += i1;
   l4 = i0;
   i1 = l4;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 4));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 4));
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   goto B0;
   B12:;
   i0 = l3;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3120));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3120));
   l7 = i1;
   i0 = i0 <= i1;
   if (i0) {goto B10;}
@@ -5337,9 +5635,9 @@ static u32 malloc(u32 p0) {
   l5 = i0;
   i1 = 3160u;
   i0 += i1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l4 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   p0 = i0;
   i1 = l5;
   i2 = 3152u;
@@ -5354,19 +5652,19 @@ static u32 malloc(u32 p0) {
   i2 = I32_ROTL(i2, i3);
   i1 &= i2;
   l2 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3112), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3112), i1);
   goto B16;
   B17:;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3128));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3128));
   i1 = p0;
   i0 = i0 > i1;
   i0 = p0;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l5;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   B16:;
   i0 = l4;
   i1 = 8u;
@@ -5376,7 +5674,7 @@ static u32 malloc(u32 p0) {
   i1 = l3;
   i2 = 3u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l4;
   i1 = l3;
   i0 += i1;
@@ -5390,12 +5688,12 @@ static u32 malloc(u32 p0) {
   l6 = i1;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l4;
   i1 = l8;
   i0 += i1;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l7;
   i0 = !(i0);
   if (i0) {goto B18;}
@@ -5409,7 +5707,7 @@ static u32 malloc(u32 p0) {
   i0 += i1;
   l3 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3132));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3132));
   l4 = i0;
   i0 = l2;
   i1 = 1u;
@@ -5422,38 +5720,38 @@ static u32 malloc(u32 p0) {
   i1 = l2;
   i2 = l8;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3112), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3112), i1);
   i0 = l3;
   l8 = i0;
   goto B19;
   B20:;
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   l8 = i0;
   B19:;
   i0 = l3;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   i0 = l8;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l4;
   i1 = l3;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l4;
   i1 = l8;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   B18:;
   i0 = 0u;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3132), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3132), i1);
   i0 = 0u;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3120), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3120), i1);
   goto B0;
   B15:;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3116));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3116));
   l9 = i0;
   i0 = !(i0);
   if (i0) {goto B10;}
@@ -5518,9 +5816,9 @@ static u32 malloc(u32 p0) {
   i0 <<= (i1 & 31);
   i1 = 3416u;
   i0 += i1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l5 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
   i1 = 4294967288u;
   i0 &= i1;
   i1 = l3;
@@ -5529,20 +5827,21 @@ static u32 malloc(u32 p0) {
   i0 = l5;
   l6 = i0;
   L22: 
+    EPOCH_CHECK;
     i0 = l6;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
     p0 = i0;
     if (i0) {goto B23;}
     i0 = l6;
     i1 = 20u;
     i0 += i1;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     p0 = i0;
     i0 = !(i0);
     if (i0) {goto B21;}
     B23:;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
     i1 = 4294967288u;
     i0 &= i1;
     i1 = l3;
@@ -5566,43 +5865,43 @@ static u32 malloc(u32 p0) {
   UNREACHABLE;
   B21:;
   i0 = l5;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 24));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 24));
   l10 = i0;
   i0 = l5;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   l8 = i0;
   i1 = l5;
   i0 = i0 == i1;
   if (i0) {goto B24;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3128));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3128));
   i1 = l5;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 8));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 8));
   p0 = i1;
   i0 = i0 > i1;
   if (i0) {goto B25;}
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   i1 = l5;
   i0 = i0 != i1;
   B25:;
   i0 = p0;
   i1 = l8;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l8;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B1;
   B24:;
   i0 = l5;
   i1 = 20u;
   i0 += i1;
   l6 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   p0 = i0;
   if (i0) {goto B26;}
   i0 = l5;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
   p0 = i0;
   i0 = !(i0);
   if (i0) {goto B9;}
@@ -5612,6 +5911,7 @@ static u32 malloc(u32 p0) {
   l6 = i0;
   B26:;
   L27: 
+    EPOCH_CHECK;
     i0 = l6;
     l11 = i0;
     i0 = p0;
@@ -5619,7 +5919,7 @@ static u32 malloc(u32 p0) {
     i1 = 20u;
     i0 += i1;
     l6 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     p0 = i0;
     if (i0) {goto L27;}
     i0 = l8;
@@ -5627,12 +5927,12 @@ static u32 malloc(u32 p0) {
     i0 += i1;
     l6 = i0;
     i0 = l8;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
     p0 = i0;
     if (i0) {goto L27;}
   i0 = l11;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   goto B1;
   B11:;
   i0 = 4294967295u;
@@ -5649,7 +5949,7 @@ static u32 malloc(u32 p0) {
   i0 &= i1;
   l3 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3116));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3116));
   l7 = i0;
   i0 = !(i0);
   if (i0) {goto B10;}
@@ -5729,7 +6029,7 @@ static u32 malloc(u32 p0) {
   i0 <<= (i1 & 31);
   i1 = 3416u;
   i0 += i1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l4 = i0;
   if (i0) {goto B32;}
   i0 = 0u;
@@ -5756,8 +6056,9 @@ static u32 malloc(u32 p0) {
   i0 = 0u;
   l8 = i0;
   L33: 
+    EPOCH_CHECK;
     i0 = l4;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
     i1 = 4294967288u;
     i0 &= i1;
     i1 = l3;
@@ -5784,7 +6085,7 @@ static u32 malloc(u32 p0) {
     i1 = l4;
     i2 = 20u;
     i1 += i2;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
     l2 = i1;
     i2 = l2;
     i3 = l4;
@@ -5796,7 +6097,7 @@ static u32 malloc(u32 p0) {
     i3 += i4;
     i4 = 16u;
     i3 += i4;
-    i3 = i32_load(Z_envZ_memory, (u64)(i3));
+    i3 = i32_load(instance->Z_envZ_memory, (u64)(i3));
     l4 = i3;
     i2 = i2 == i3;
     i0 = i2 ? i0 : i1;
@@ -5891,7 +6192,7 @@ static u32 malloc(u32 p0) {
   i0 <<= (i1 & 31);
   i1 = 3416u;
   i0 += i1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   p0 = i0;
   B35:;
   i0 = p0;
@@ -5899,8 +6200,9 @@ static u32 malloc(u32 p0) {
   if (i0) {goto B29;}
   B30:;
   L36: 
+    EPOCH_CHECK;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
     i1 = 4294967288u;
     i0 &= i1;
     i1 = l3;
@@ -5910,13 +6212,13 @@ static u32 malloc(u32 p0) {
     i0 = i0 < i1;
     l5 = i0;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
     l4 = i0;
     if (i0) {goto B37;}
     i0 = p0;
     i1 = 20u;
     i0 += i1;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     l4 = i0;
     B37:;
     i0 = l2;
@@ -5939,49 +6241,49 @@ static u32 malloc(u32 p0) {
   if (i0) {goto B10;}
   i0 = l6;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3120));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3120));
   i2 = l3;
   i1 -= i2;
   i0 = i0 >= i1;
   if (i0) {goto B10;}
   i0 = l8;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 24));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 24));
   l11 = i0;
   i0 = l8;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   l5 = i0;
   i1 = l8;
   i0 = i0 == i1;
   if (i0) {goto B38;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3128));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3128));
   i1 = l8;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 8));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 8));
   p0 = i1;
   i0 = i0 > i1;
   if (i0) {goto B39;}
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   i1 = l8;
   i0 = i0 != i1;
   B39:;
   i0 = p0;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l5;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B2;
   B38:;
   i0 = l8;
   i1 = 20u;
   i0 += i1;
   l4 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   p0 = i0;
   if (i0) {goto B40;}
   i0 = l8;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
   p0 = i0;
   i0 = !(i0);
   if (i0) {goto B8;}
@@ -5991,6 +6293,7 @@ static u32 malloc(u32 p0) {
   l4 = i0;
   B40:;
   L41: 
+    EPOCH_CHECK;
     i0 = l4;
     l2 = i0;
     i0 = p0;
@@ -5998,7 +6301,7 @@ static u32 malloc(u32 p0) {
     i1 = 20u;
     i0 += i1;
     l4 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     p0 = i0;
     if (i0) {goto L41;}
     i0 = l5;
@@ -6006,22 +6309,22 @@ static u32 malloc(u32 p0) {
     i0 += i1;
     l4 = i0;
     i0 = l5;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
     p0 = i0;
     if (i0) {goto L41;}
   i0 = l2;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   goto B2;
   B10:;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3120));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3120));
   p0 = i0;
   i1 = l3;
   i0 = i0 < i1;
   if (i0) {goto B42;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3132));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3132));
   l4 = i0;
   i0 = p0;
   i1 = l3;
@@ -6032,50 +6335,50 @@ static u32 malloc(u32 p0) {
   if (i0) {goto B44;}
   i0 = 0u;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3120), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3120), i1);
   i0 = 0u;
   i1 = l4;
   i2 = l3;
   i1 += i2;
   l5 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3132), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3132), i1);
   i0 = l5;
   i1 = l6;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l4;
   i1 = p0;
   i0 += i1;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l4;
   i1 = l3;
   i2 = 3u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   goto B43;
   B44:;
   i0 = 0u;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3132), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3132), i1);
   i0 = 0u;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3120), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3120), i1);
   i0 = l4;
   i1 = p0;
   i2 = 3u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l4;
   i1 = p0;
   i0 += i1;
   p0 = i0;
   i1 = p0;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 4));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 4));
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   B43:;
   i0 = l4;
   i1 = 8u;
@@ -6084,7 +6387,7 @@ static u32 malloc(u32 p0) {
   goto B0;
   B42:;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3124));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3124));
   l5 = i0;
   i1 = l3;
   i0 = i0 <= i1;
@@ -6094,25 +6397,25 @@ static u32 malloc(u32 p0) {
   i2 = l3;
   i1 -= i2;
   l4 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3124), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3124), i1);
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3136));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3136));
   p0 = i1;
   i2 = l3;
   i1 += i2;
   l6 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3136), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3136), i1);
   i0 = l6;
   i1 = l4;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = p0;
   i1 = l3;
   i2 = 3u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = p0;
   i1 = 8u;
   i0 += i1;
@@ -6120,20 +6423,20 @@ static u32 malloc(u32 p0) {
   goto B0;
   B45:;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3584));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3584));
   i0 = !(i0);
   if (i0) {goto B47;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3592));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3592));
   l4 = i0;
   goto B46;
   B47:;
   i0 = 0u;
   j1 = 18446744073709551615ull;
-  i64_store(Z_envZ_memory, (u64)(i0 + 3596), j1);
+  i64_store(instance->Z_envZ_memory, (u64)(i0 + 3596), j1);
   i0 = 0u;
   j1 = 17592186048512ull;
-  i64_store(Z_envZ_memory, (u64)(i0 + 3588), j1);
+  i64_store(instance->Z_envZ_memory, (u64)(i0 + 3588), j1);
   i0 = 0u;
   i1 = l1;
   i2 = 12u;
@@ -6142,13 +6445,13 @@ static u32 malloc(u32 p0) {
   i1 &= i2;
   i2 = 1431655768u;
   i1 ^= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3584), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3584), i1);
   i0 = 0u;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3604), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3604), i1);
   i0 = 0u;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3556), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3556), i1);
   i0 = 4096u;
   l4 = i0;
   B46:;
@@ -6173,12 +6476,12 @@ static u32 malloc(u32 p0) {
   i0 = 0u;
   p0 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3552));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3552));
   l4 = i0;
   i0 = !(i0);
   if (i0) {goto B48;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3544));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3544));
   l6 = i0;
   i1 = l8;
   i0 += i1;
@@ -6192,39 +6495,40 @@ static u32 malloc(u32 p0) {
   if (i0) {goto B0;}
   B48:;
   i0 = 0u;
-  i0 = i32_load8_u(Z_envZ_memory, (u64)(i0 + 3556));
+  i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0 + 3556));
   i1 = 4u;
   i0 &= i1;
   if (i0) {goto B5;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3136));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3136));
   l4 = i0;
   i0 = !(i0);
   if (i0) {goto B51;}
   i0 = 3560u;
   p0 = i0;
   L52: 
+    EPOCH_CHECK;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     l6 = i0;
     i1 = l4;
     i0 = i0 > i1;
     if (i0) {goto B53;}
     i0 = l6;
     i1 = p0;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 4));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 4));
     i0 += i1;
     i1 = l4;
     i0 = i0 > i1;
     if (i0) {goto B50;}
     B53:;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
     p0 = i0;
     if (i0) {goto L52;}
   B51:;
   i0 = 0u;
-  i0 = f52(i0);
+  i0 = f52(instance, i0);
   l5 = i0;
   i1 = 4294967295u;
   i0 = i0 == i1;
@@ -6232,7 +6536,7 @@ static u32 malloc(u32 p0) {
   i0 = l8;
   l2 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3588));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3588));
   p0 = i0;
   i1 = 4294967295u;
   i0 += i1;
@@ -6263,12 +6567,12 @@ static u32 malloc(u32 p0) {
   i0 = i0 > i1;
   if (i0) {goto B6;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3552));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3552));
   p0 = i0;
   i0 = !(i0);
   if (i0) {goto B55;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3544));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3544));
   l4 = i0;
   i1 = l2;
   i0 += i1;
@@ -6282,7 +6586,7 @@ static u32 malloc(u32 p0) {
   if (i0) {goto B6;}
   B55:;
   i0 = l2;
-  i0 = f52(i0);
+  i0 = f52(instance, i0);
   p0 = i0;
   i1 = l5;
   i0 = i0 != i1;
@@ -6299,12 +6603,12 @@ static u32 malloc(u32 p0) {
   i0 = i0 > i1;
   if (i0) {goto B6;}
   i0 = l2;
-  i0 = f52(i0);
+  i0 = f52(instance, i0);
   l5 = i0;
   i1 = p0;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   i2 = p0;
-  i2 = i32_load(Z_envZ_memory, (u64)(i2 + 4));
+  i2 = i32_load(instance->Z_envZ_memory, (u64)(i2 + 4));
   i1 += i2;
   i0 = i0 == i1;
   if (i0) {goto B7;}
@@ -6331,7 +6635,7 @@ static u32 malloc(u32 p0) {
   i1 = l2;
   i0 -= i1;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3592));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3592));
   p0 = i1;
   i0 += i1;
   i1 = 0u;
@@ -6343,7 +6647,7 @@ static u32 malloc(u32 p0) {
   i0 = i0 > i1;
   if (i0) {goto B4;}
   i0 = p0;
-  i0 = f52(i0);
+  i0 = f52(instance, i0);
   i1 = 4294967295u;
   i0 = i0 == i1;
   if (i0) {goto B57;}
@@ -6356,7 +6660,7 @@ static u32 malloc(u32 p0) {
   i0 = 0u;
   i1 = l2;
   i0 -= i1;
-  i0 = f52(i0);
+  i0 = f52(instance, i0);
   goto B6;
   B56:;
   i0 = l5;
@@ -6380,20 +6684,20 @@ static u32 malloc(u32 p0) {
   B6:;
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3556));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3556));
   i2 = 4u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3556), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3556), i1);
   B5:;
   i0 = l8;
   i1 = 2147483646u;
   i0 = i0 > i1;
   if (i0) {goto B3;}
   i0 = l8;
-  i0 = f52(i0);
+  i0 = f52(instance, i0);
   l5 = i0;
   i1 = 0u;
-  i1 = f52(i1);
+  i1 = f52(instance, i1);
   p0 = i1;
   i0 = i0 >= i1;
   if (i0) {goto B3;}
@@ -6417,47 +6721,48 @@ static u32 malloc(u32 p0) {
   B4:;
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3544));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3544));
   i2 = l2;
   i1 += i2;
   p0 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3544), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3544), i1);
   i0 = p0;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3548));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3548));
   i0 = i0 <= i1;
   if (i0) {goto B58;}
   i0 = 0u;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3548), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3548), i1);
   B58:;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3136));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3136));
   l4 = i0;
   i0 = !(i0);
   if (i0) {goto B62;}
   i0 = 3560u;
   p0 = i0;
   L63: 
+    EPOCH_CHECK;
     i0 = l5;
     i1 = p0;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
     l6 = i1;
     i2 = p0;
-    i2 = i32_load(Z_envZ_memory, (u64)(i2 + 4));
+    i2 = i32_load(instance->Z_envZ_memory, (u64)(i2 + 4));
     l8 = i2;
     i1 += i2;
     i0 = i0 == i1;
     if (i0) {goto B61;}
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
     p0 = i0;
     if (i0) {goto L63;}
     goto B60;
   UNREACHABLE;
   B62:;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3128));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3128));
   p0 = i0;
   i0 = !(i0);
   if (i0) {goto B65;}
@@ -6468,27 +6773,28 @@ static u32 malloc(u32 p0) {
   B65:;
   i0 = 0u;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3128), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3128), i1);
   B64:;
   i0 = 0u;
   p0 = i0;
   i0 = 0u;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3564), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3564), i1);
   i0 = 0u;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3560), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3560), i1);
   i0 = 0u;
   i1 = 4294967295u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3144), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3144), i1);
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3584));
-  i32_store(Z_envZ_memory, (u64)(i0 + 3148), i1);
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3584));
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3148), i1);
   i0 = 0u;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3572), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3572), i1);
   L66: 
+    EPOCH_CHECK;
     i0 = p0;
     i1 = 3u;
     i0 <<= (i1 & 31);
@@ -6499,12 +6805,12 @@ static u32 malloc(u32 p0) {
     i2 = 3152u;
     i1 += i2;
     l6 = i1;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = l4;
     i1 = 3164u;
     i0 += i1;
     i1 = l6;
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = p0;
     i1 = 1u;
     i0 += i1;
@@ -6532,31 +6838,31 @@ static u32 malloc(u32 p0) {
   l4 = i2;
   i1 -= i2;
   l6 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3124), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3124), i1);
   i0 = 0u;
   i1 = l5;
   i2 = l4;
   i1 += i2;
   l4 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3136), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3136), i1);
   i0 = l4;
   i1 = l6;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l5;
   i1 = p0;
   i0 += i1;
   i1 = 40u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3600));
-  i32_store(Z_envZ_memory, (u64)(i0 + 3140), i1);
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3600));
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3140), i1);
   goto B59;
   B61:;
   i0 = p0;
-  i0 = i32_load8_u(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0 + 12));
   i1 = 8u;
   i0 &= i1;
   if (i0) {goto B60;}
@@ -6572,7 +6878,7 @@ static u32 malloc(u32 p0) {
   i1 = l8;
   i2 = l2;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = 0u;
   i1 = l4;
   i2 = 4294967288u;
@@ -6590,42 +6896,42 @@ static u32 malloc(u32 p0) {
   p0 = i2;
   i1 += i2;
   l6 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3136), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3136), i1);
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3124));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3124));
   i2 = l2;
   i1 += i2;
   l5 = i1;
   i2 = p0;
   i1 -= i2;
   p0 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3124), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3124), i1);
   i0 = l6;
   i1 = p0;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l4;
   i1 = l5;
   i0 += i1;
   i1 = 40u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3600));
-  i32_store(Z_envZ_memory, (u64)(i0 + 3140), i1);
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3600));
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3140), i1);
   goto B59;
   B60:;
   i0 = l5;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3128));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3128));
   l8 = i1;
   i0 = i0 >= i1;
   if (i0) {goto B67;}
   i0 = 0u;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3128), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3128), i1);
   i0 = l5;
   l8 = i0;
   B67:;
@@ -6636,20 +6942,21 @@ static u32 malloc(u32 p0) {
   i0 = 3560u;
   p0 = i0;
   L75: 
+    EPOCH_CHECK;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     i1 = l6;
     i0 = i0 == i1;
     if (i0) {goto B74;}
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
     p0 = i0;
     if (i0) {goto L75;}
     goto B73;
   UNREACHABLE;
   B74:;
   i0 = p0;
-  i0 = i32_load8_u(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load8_u(instance->Z_envZ_memory, (u64)(i0 + 12));
   i1 = 8u;
   i0 &= i1;
   i0 = !(i0);
@@ -6658,15 +6965,16 @@ static u32 malloc(u32 p0) {
   i0 = 3560u;
   p0 = i0;
   L76: 
+    EPOCH_CHECK;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     l6 = i0;
     i1 = l4;
     i0 = i0 > i1;
     if (i0) {goto B77;}
     i0 = l6;
     i1 = p0;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 4));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 4));
     i0 += i1;
     l6 = i0;
     i1 = l4;
@@ -6674,20 +6982,20 @@ static u32 malloc(u32 p0) {
     if (i0) {goto B71;}
     B77:;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
     p0 = i0;
     goto L76;
   UNREACHABLE;
   B72:;
   i0 = p0;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p0;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 4));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 4));
   i2 = l2;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l5;
   i1 = 4294967288u;
   i2 = l5;
@@ -6706,7 +7014,7 @@ static u32 malloc(u32 p0) {
   i1 = l3;
   i2 = 3u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l6;
   i1 = 4294967288u;
   i2 = l6;
@@ -6737,50 +7045,50 @@ static u32 malloc(u32 p0) {
   if (i0) {goto B78;}
   i0 = 0u;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3136), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3136), i1);
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3124));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3124));
   i2 = p0;
   i1 += i2;
   p0 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3124), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3124), i1);
   i0 = l6;
   i1 = p0;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   goto B69;
   B78:;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3132));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3132));
   i1 = l5;
   i0 = i0 != i1;
   if (i0) {goto B79;}
   i0 = 0u;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3132), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3132), i1);
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3120));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3120));
   i2 = p0;
   i1 += i2;
   p0 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3120), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3120), i1);
   i0 = l6;
   i1 = p0;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l6;
   i1 = p0;
   i0 += i1;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   goto B69;
   B79:;
   i0 = l5;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
   l4 = i0;
   i1 = 3u;
   i0 &= i1;
@@ -6796,10 +7104,10 @@ static u32 malloc(u32 p0) {
   i0 = i0 > i1;
   if (i0) {goto B82;}
   i0 = l5;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   l3 = i0;
   i0 = l5;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   l2 = i0;
   i1 = l4;
   i2 = 3u;
@@ -6822,12 +7130,12 @@ static u32 malloc(u32 p0) {
   if (i0) {goto B84;}
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3112));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3112));
   i2 = 4294967294u;
   i3 = l9;
   i2 = I32_ROTL(i2, i3);
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3112), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3112), i1);
   goto B81;
   B84:;
   i0 = l3;
@@ -6840,52 +7148,52 @@ static u32 malloc(u32 p0) {
   B85:;
   i0 = l2;
   i1 = l3;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l3;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B81;
   B82:;
   i0 = l5;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 24));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 24));
   l9 = i0;
   i0 = l5;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   l2 = i0;
   i1 = l5;
   i0 = i0 == i1;
   if (i0) {goto B87;}
   i0 = l8;
   i1 = l5;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 8));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 8));
   l4 = i1;
   i0 = i0 > i1;
   if (i0) {goto B88;}
   i0 = l4;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   i1 = l5;
   i0 = i0 != i1;
   B88:;
   i0 = l4;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l2;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B86;
   B87:;
   i0 = l5;
   i1 = 20u;
   i0 += i1;
   l4 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l3 = i0;
   if (i0) {goto B89;}
   i0 = l5;
   i1 = 16u;
   i0 += i1;
   l4 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l3 = i0;
   if (i0) {goto B89;}
   i0 = 0u;
@@ -6893,6 +7201,7 @@ static u32 malloc(u32 p0) {
   goto B86;
   B89:;
   L90: 
+    EPOCH_CHECK;
     i0 = l4;
     l8 = i0;
     i0 = l3;
@@ -6900,7 +7209,7 @@ static u32 malloc(u32 p0) {
     i1 = 20u;
     i0 += i1;
     l4 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     l3 = i0;
     if (i0) {goto L90;}
     i0 = l2;
@@ -6908,75 +7217,75 @@ static u32 malloc(u32 p0) {
     i0 += i1;
     l4 = i0;
     i0 = l2;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
     l3 = i0;
     if (i0) {goto L90;}
   i0 = l8;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   B86:;
   i0 = l9;
   i0 = !(i0);
   if (i0) {goto B81;}
   i0 = l5;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 28));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 28));
   l3 = i0;
   i1 = 2u;
   i0 <<= (i1 & 31);
   i1 = 3416u;
   i0 += i1;
   l4 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   i1 = l5;
   i0 = i0 != i1;
   if (i0) {goto B92;}
   i0 = l4;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l2;
   if (i0) {goto B91;}
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3116));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3116));
   i2 = 4294967294u;
   i3 = l3;
   i2 = I32_ROTL(i2, i3);
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3116), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3116), i1);
   goto B81;
   B92:;
   i0 = l9;
   i1 = 16u;
   i2 = 20u;
   i3 = l9;
-  i3 = i32_load(Z_envZ_memory, (u64)(i3 + 16));
+  i3 = i32_load(instance->Z_envZ_memory, (u64)(i3 + 16));
   i4 = l5;
   i3 = i3 == i4;
   i1 = i3 ? i1 : i2;
   i0 += i1;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l2;
   i0 = !(i0);
   if (i0) {goto B81;}
   B91:;
   i0 = l2;
   i1 = l9;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   i0 = l5;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
   l4 = i0;
   i0 = !(i0);
   if (i0) {goto B93;}
   i0 = l2;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 16), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 16), i1);
   i0 = l4;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   B93:;
   i0 = l5;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 20));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 20));
   l4 = i0;
   i0 = !(i0);
   if (i0) {goto B81;}
@@ -6984,10 +7293,10 @@ static u32 malloc(u32 p0) {
   i1 = 20u;
   i0 += i1;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l4;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   B81:;
   i0 = l7;
   i1 = p0;
@@ -7000,20 +7309,20 @@ static u32 malloc(u32 p0) {
   B80:;
   i0 = l5;
   i1 = l5;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 4));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 4));
   i2 = 4294967294u;
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l6;
   i1 = p0;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l6;
   i1 = p0;
   i0 += i1;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = 255u;
   i0 = i0 > i1;
@@ -7028,7 +7337,7 @@ static u32 malloc(u32 p0) {
   i0 += i1;
   p0 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3112));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3112));
   l3 = i0;
   i1 = 1u;
   i2 = l4;
@@ -7040,27 +7349,27 @@ static u32 malloc(u32 p0) {
   i1 = l3;
   i2 = l4;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3112), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3112), i1);
   i0 = p0;
   l4 = i0;
   goto B95;
   B96:;
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   l4 = i0;
   B95:;
   i0 = p0;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   i0 = l4;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l6;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l6;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B69;
   B94:;
   i0 = 0u;
@@ -7132,10 +7441,10 @@ static u32 malloc(u32 p0) {
   B97:;
   i0 = l6;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 28), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 28), i1);
   i0 = l6;
   j1 = 0ull;
-  i64_store(Z_envZ_memory, (u64)(i0 + 16), j1);
+  i64_store(instance->Z_envZ_memory, (u64)(i0 + 16), j1);
   i0 = l4;
   i1 = 2u;
   i0 <<= (i1 & 31);
@@ -7143,7 +7452,7 @@ static u32 malloc(u32 p0) {
   i0 += i1;
   l3 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3116));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3116));
   l5 = i0;
   i1 = 1u;
   i2 = l4;
@@ -7155,13 +7464,13 @@ static u32 malloc(u32 p0) {
   i1 = l5;
   i2 = l8;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3116), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3116), i1);
   i0 = l3;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l6;
   i1 = l3;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   goto B98;
   B99:;
   i0 = p0;
@@ -7178,12 +7487,13 @@ static u32 malloc(u32 p0) {
   i0 <<= (i1 & 31);
   l4 = i0;
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l5 = i0;
   L100: 
+    EPOCH_CHECK;
     i0 = l5;
     l3 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
     i1 = 4294967288u;
     i0 &= i1;
     i1 = p0;
@@ -7205,22 +7515,22 @@ static u32 malloc(u32 p0) {
     i1 = 16u;
     i0 += i1;
     l8 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     l5 = i0;
     if (i0) {goto L100;}
   i0 = l8;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l6;
   i1 = l3;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   B98:;
   i0 = l6;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l6;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B69;
   B71:;
   i0 = 0u;
@@ -7243,27 +7553,27 @@ static u32 malloc(u32 p0) {
   l8 = i2;
   i1 -= i2;
   l11 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3124), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3124), i1);
   i0 = 0u;
   i1 = l5;
   i2 = l8;
   i1 += i2;
   l8 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3136), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3136), i1);
   i0 = l8;
   i1 = l11;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l5;
   i1 = p0;
   i0 += i1;
   i1 = 40u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3600));
-  i32_store(Z_envZ_memory, (u64)(i0 + 3140), i1);
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3600));
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3140), i1);
   i0 = l4;
   i1 = l6;
   i2 = 39u;
@@ -7290,39 +7600,40 @@ static u32 malloc(u32 p0) {
   i0 = i2 ? i0 : i1;
   l8 = i0;
   i1 = 27u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l8;
   i1 = 16u;
   i0 += i1;
   i1 = 0u;
-  j1 = i64_load(Z_envZ_memory, (u64)(i1 + 3568));
-  i64_store(Z_envZ_memory, (u64)(i0), j1);
+  j1 = i64_load(instance->Z_envZ_memory, (u64)(i1 + 3568));
+  i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
   i0 = l8;
   i1 = 0u;
-  j1 = i64_load(Z_envZ_memory, (u64)(i1 + 3560));
-  i64_store(Z_envZ_memory, (u64)(i0 + 8), j1);
+  j1 = i64_load(instance->Z_envZ_memory, (u64)(i1 + 3560));
+  i64_store(instance->Z_envZ_memory, (u64)(i0 + 8), j1);
   i0 = 0u;
   i1 = l8;
   i2 = 8u;
   i1 += i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3568), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3568), i1);
   i0 = 0u;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3564), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3564), i1);
   i0 = 0u;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3560), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3560), i1);
   i0 = 0u;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3572), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3572), i1);
   i0 = l8;
   i1 = 24u;
   i0 += i1;
   p0 = i0;
   L101: 
+    EPOCH_CHECK;
     i0 = p0;
     i1 = 7u;
-    i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
     i0 = p0;
     i1 = 8u;
     i0 += i1;
@@ -7341,10 +7652,10 @@ static u32 malloc(u32 p0) {
   if (i0) {goto B59;}
   i0 = l8;
   i1 = l8;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 4));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 4));
   i2 = 4294967294u;
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l4;
   i1 = l8;
   i2 = l4;
@@ -7352,10 +7663,10 @@ static u32 malloc(u32 p0) {
   l2 = i1;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l8;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l2;
   i1 = 255u;
   i0 = i0 > i1;
@@ -7370,7 +7681,7 @@ static u32 malloc(u32 p0) {
   i0 += i1;
   p0 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3112));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3112));
   l5 = i0;
   i1 = 1u;
   i2 = l6;
@@ -7382,27 +7693,27 @@ static u32 malloc(u32 p0) {
   i1 = l5;
   i2 = l6;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3112), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3112), i1);
   i0 = p0;
   l6 = i0;
   goto B103;
   B104:;
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   l6 = i0;
   B103:;
   i0 = p0;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   i0 = l6;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l4;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l4;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B59;
   B102:;
   i0 = 0u;
@@ -7474,12 +7785,12 @@ static u32 malloc(u32 p0) {
   B105:;
   i0 = l4;
   j1 = 0ull;
-  i64_store(Z_envZ_memory, (u64)(i0 + 16), j1);
+  i64_store(instance->Z_envZ_memory, (u64)(i0 + 16), j1);
   i0 = l4;
   i1 = 28u;
   i0 += i1;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = 2u;
   i0 <<= (i1 & 31);
@@ -7487,7 +7798,7 @@ static u32 malloc(u32 p0) {
   i0 += i1;
   l6 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3116));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3116));
   l5 = i0;
   i1 = 1u;
   i2 = p0;
@@ -7499,15 +7810,15 @@ static u32 malloc(u32 p0) {
   i1 = l5;
   i2 = l8;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3116), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3116), i1);
   i0 = l6;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l4;
   i1 = 24u;
   i0 += i1;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   goto B106;
   B107:;
   i0 = l2;
@@ -7524,12 +7835,13 @@ static u32 malloc(u32 p0) {
   i0 <<= (i1 & 31);
   p0 = i0;
   i0 = l6;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l5 = i0;
   L108: 
+    EPOCH_CHECK;
     i0 = l5;
     l6 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
     i1 = 4294967288u;
     i0 &= i1;
     i1 = l2;
@@ -7551,43 +7863,43 @@ static u32 malloc(u32 p0) {
     i1 = 16u;
     i0 += i1;
     l8 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     l5 = i0;
     if (i0) {goto L108;}
   i0 = l8;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l4;
   i1 = 24u;
   i0 += i1;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   B106:;
   i0 = l4;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l4;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B59;
   B70:;
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   p0 = i0;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l3;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   i0 = l6;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   i0 = l6;
   i1 = l3;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l6;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   B69:;
   i0 = l11;
   i1 = 8u;
@@ -7596,27 +7908,27 @@ static u32 malloc(u32 p0) {
   goto B0;
   B68:;
   i0 = l6;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   p0 = i0;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l6;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   i0 = l4;
   i1 = 24u;
   i0 += i1;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l4;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l4;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   B59:;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3124));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3124));
   p0 = i0;
   i1 = l3;
   i0 = i0 <= i1;
@@ -7626,34 +7938,34 @@ static u32 malloc(u32 p0) {
   i2 = l3;
   i1 -= i2;
   l4 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3124), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3124), i1);
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3136));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3136));
   p0 = i1;
   i2 = l3;
   i1 += i2;
   l6 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3136), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3136), i1);
   i0 = l6;
   i1 = l4;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = p0;
   i1 = l3;
   i2 = 3u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = p0;
   i1 = 8u;
   i0 += i1;
   p0 = i0;
   goto B0;
   B3:;
-  i0 = __errno_location();
+  i0 = __errno_location(instance);
   i1 = 48u;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = 0u;
   p0 = i0;
   goto B0;
@@ -7663,19 +7975,19 @@ static u32 malloc(u32 p0) {
   if (i0) {goto B109;}
   i0 = l8;
   i1 = l8;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 28));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 28));
   l4 = i1;
   i2 = 2u;
   i1 <<= (i2 & 31);
   i2 = 3416u;
   i1 += i2;
   p0 = i1;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   i0 = i0 != i1;
   if (i0) {goto B111;}
   i0 = p0;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l5;
   if (i0) {goto B110;}
   i0 = 0u;
@@ -7685,43 +7997,43 @@ static u32 malloc(u32 p0) {
   i2 = I32_ROTL(i2, i3);
   i1 &= i2;
   l7 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3116), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3116), i1);
   goto B109;
   B111:;
   i0 = l11;
   i1 = 16u;
   i2 = 20u;
   i3 = l11;
-  i3 = i32_load(Z_envZ_memory, (u64)(i3 + 16));
+  i3 = i32_load(instance->Z_envZ_memory, (u64)(i3 + 16));
   i4 = l8;
   i3 = i3 == i4;
   i1 = i3 ? i1 : i2;
   i0 += i1;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l5;
   i0 = !(i0);
   if (i0) {goto B109;}
   B110:;
   i0 = l5;
   i1 = l11;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   i0 = l8;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
   p0 = i0;
   i0 = !(i0);
   if (i0) {goto B112;}
   i0 = l5;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 16), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 16), i1);
   i0 = p0;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   B112:;
   i0 = l8;
   i1 = 20u;
   i0 += i1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   p0 = i0;
   i0 = !(i0);
   if (i0) {goto B109;}
@@ -7729,10 +8041,10 @@ static u32 malloc(u32 p0) {
   i1 = 20u;
   i0 += i1;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   B109:;
   i0 = l6;
   i1 = 15u;
@@ -7745,23 +8057,23 @@ static u32 malloc(u32 p0) {
   p0 = i1;
   i2 = 3u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l8;
   i1 = p0;
   i0 += i1;
   p0 = i0;
   i1 = p0;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 4));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 4));
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   goto B113;
   B114:;
   i0 = l8;
   i1 = l3;
   i2 = 3u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l8;
   i1 = l3;
   i0 += i1;
@@ -7769,12 +8081,12 @@ static u32 malloc(u32 p0) {
   i1 = l6;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l5;
   i1 = l6;
   i0 += i1;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l6;
   i1 = 255u;
   i0 = i0 > i1;
@@ -7789,7 +8101,7 @@ static u32 malloc(u32 p0) {
   i0 += i1;
   p0 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3112));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3112));
   l6 = i0;
   i1 = 1u;
   i2 = l4;
@@ -7801,27 +8113,27 @@ static u32 malloc(u32 p0) {
   i1 = l6;
   i2 = l4;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3112), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3112), i1);
   i0 = p0;
   l4 = i0;
   goto B116;
   B117:;
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   l4 = i0;
   B116:;
   i0 = p0;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   i0 = l4;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l5;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l5;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B113;
   B115:;
   i0 = l6;
@@ -7894,10 +8206,10 @@ static u32 malloc(u32 p0) {
   B118:;
   i0 = l5;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 28), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 28), i1);
   i0 = l5;
   j1 = 0ull;
-  i64_store(Z_envZ_memory, (u64)(i0 + 16), j1);
+  i64_store(instance->Z_envZ_memory, (u64)(i0 + 16), j1);
   i0 = p0;
   i1 = 2u;
   i0 <<= (i1 & 31);
@@ -7915,13 +8227,13 @@ static u32 malloc(u32 p0) {
   i1 = l7;
   i2 = l3;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3116), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3116), i1);
   i0 = l4;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l5;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   goto B121;
   B122:;
   i0 = l6;
@@ -7938,12 +8250,13 @@ static u32 malloc(u32 p0) {
   i0 <<= (i1 & 31);
   p0 = i0;
   i0 = l4;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l3 = i0;
   L123: 
+    EPOCH_CHECK;
     i0 = l3;
     l4 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
     i1 = 4294967288u;
     i0 &= i1;
     i1 = l6;
@@ -7965,41 +8278,41 @@ static u32 malloc(u32 p0) {
     i1 = 16u;
     i0 += i1;
     l2 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     l3 = i0;
     if (i0) {goto L123;}
   i0 = l2;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l5;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   B121:;
   i0 = l5;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l5;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B113;
   B120:;
   i0 = l4;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   p0 = i0;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l4;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   i0 = l5;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   i0 = l5;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l5;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   B113:;
   i0 = l8;
   i1 = 8u;
@@ -8012,19 +8325,19 @@ static u32 malloc(u32 p0) {
   if (i0) {goto B124;}
   i0 = l5;
   i1 = l5;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 28));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 28));
   l6 = i1;
   i2 = 2u;
   i1 <<= (i2 & 31);
   i2 = 3416u;
   i1 += i2;
   p0 = i1;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   i0 = i0 != i1;
   if (i0) {goto B126;}
   i0 = p0;
   i1 = l8;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l8;
   if (i0) {goto B125;}
   i0 = 0u;
@@ -8033,43 +8346,43 @@ static u32 malloc(u32 p0) {
   i3 = l6;
   i2 = I32_ROTL(i2, i3);
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3116), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3116), i1);
   goto B124;
   B126:;
   i0 = l10;
   i1 = 16u;
   i2 = 20u;
   i3 = l10;
-  i3 = i32_load(Z_envZ_memory, (u64)(i3 + 16));
+  i3 = i32_load(instance->Z_envZ_memory, (u64)(i3 + 16));
   i4 = l5;
   i3 = i3 == i4;
   i1 = i3 ? i1 : i2;
   i0 += i1;
   i1 = l8;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l8;
   i0 = !(i0);
   if (i0) {goto B124;}
   B125:;
   i0 = l8;
   i1 = l10;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   i0 = l5;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
   p0 = i0;
   i0 = !(i0);
   if (i0) {goto B127;}
   i0 = l8;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 16), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 16), i1);
   i0 = p0;
   i1 = l8;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   B127:;
   i0 = l5;
   i1 = 20u;
   i0 += i1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   p0 = i0;
   i0 = !(i0);
   if (i0) {goto B124;}
@@ -8077,10 +8390,10 @@ static u32 malloc(u32 p0) {
   i1 = 20u;
   i0 += i1;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = l8;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   B124:;
   i0 = l4;
   i1 = 15u;
@@ -8093,23 +8406,23 @@ static u32 malloc(u32 p0) {
   p0 = i1;
   i2 = 3u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l5;
   i1 = p0;
   i0 += i1;
   p0 = i0;
   i1 = p0;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 4));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 4));
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   goto B128;
   B129:;
   i0 = l5;
   i1 = l3;
   i2 = 3u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l5;
   i1 = l3;
   i0 += i1;
@@ -8117,12 +8430,12 @@ static u32 malloc(u32 p0) {
   i1 = l4;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l6;
   i1 = l4;
   i0 += i1;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l7;
   i0 = !(i0);
   if (i0) {goto B130;}
@@ -8136,7 +8449,7 @@ static u32 malloc(u32 p0) {
   i0 += i1;
   l3 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3132));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3132));
   p0 = i0;
   i0 = 1u;
   i1 = l8;
@@ -8149,52 +8462,63 @@ static u32 malloc(u32 p0) {
   i1 = l8;
   i2 = l2;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3112), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3112), i1);
   i0 = l3;
   l8 = i0;
   goto B131;
   B132:;
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   l8 = i0;
   B131:;
   i0 = l3;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   i0 = l8;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = p0;
   i1 = l3;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = p0;
   i1 = l8;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   B130:;
   i0 = 0u;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3132), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3132), i1);
   i0 = 0u;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3120), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3120), i1);
   B128:;
   i0 = l5;
   i1 = 8u;
   i0 += i1;
   p0 = i0;
   B0:;
+#if !HELLO_PROMOTE_SLOTS
   i0 = l1;
   i1 = 16u;
   i0 += i1;
-  g0 = i0;
+  instance->globals.g0 = i0;
+#endif
   i0 = p0;
   FUNC_EPILOGUE;
   return i0;
 }
+#endif
 
-static void free(u32 p0) {
-  u32 l1 = 0, l2 = 0, l3 = 0, l4 = 0, l5 = 0, l6 = 0, l7 = 0;
+#if HELLO_ARENA_MALLOC
+static void free(hello_instance_t* instance, u32 p0) {
   FUNC_PROLOGUE;
+  (*Z_envZ_freeZ_vi)(instance, p0);
+  FUNC_EPILOGUE;
+}
+#else
+static void free(hello_instance_t* instance, u32 p0) {
+  u32 l1 = 0, l2 = 0, l3 = 0, l4 = 0, l5 = 0, l6 = 0, l7 = 0;
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1, i2, i3, i4;
   u64 j1;
   i0 = p0;
@@ -8207,7 +8531,7 @@ static void free(u32 p0) {
   i1 = p0;
   i2 = 4294967292u;
   i1 += i2;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   l2 = i1;
   i2 = 4294967288u;
   i1 &= i2;
@@ -8225,12 +8549,12 @@ static void free(u32 p0) {
   if (i0) {goto B0;}
   i0 = l1;
   i1 = l1;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
   l2 = i1;
   i0 -= i1;
   l1 = i0;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3128));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3128));
   l4 = i1;
   i0 = i0 < i1;
   if (i0) {goto B0;}
@@ -8239,7 +8563,7 @@ static void free(u32 p0) {
   i0 += i1;
   p0 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3132));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3132));
   i1 = l1;
   i0 = i0 == i1;
   if (i0) {goto B2;}
@@ -8248,10 +8572,10 @@ static void free(u32 p0) {
   i0 = i0 > i1;
   if (i0) {goto B3;}
   i0 = l1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   l5 = i0;
   i0 = l1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   l6 = i0;
   i1 = l2;
   i2 = 3u;
@@ -8274,12 +8598,12 @@ static void free(u32 p0) {
   if (i0) {goto B5;}
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3112));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3112));
   i2 = 4294967294u;
   i3 = l7;
   i2 = I32_ROTL(i2, i3);
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3112), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3112), i1);
   goto B1;
   B5:;
   i0 = l5;
@@ -8292,52 +8616,52 @@ static void free(u32 p0) {
   B6:;
   i0 = l6;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l5;
   i1 = l6;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B1;
   B3:;
   i0 = l1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 24));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 24));
   l7 = i0;
   i0 = l1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   l5 = i0;
   i1 = l1;
   i0 = i0 == i1;
   if (i0) {goto B8;}
   i0 = l4;
   i1 = l1;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 8));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 8));
   l2 = i1;
   i0 = i0 > i1;
   if (i0) {goto B9;}
   i0 = l2;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   i1 = l1;
   i0 = i0 != i1;
   B9:;
   i0 = l2;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l5;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B7;
   B8:;
   i0 = l1;
   i1 = 20u;
   i0 += i1;
   l2 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l4 = i0;
   if (i0) {goto B10;}
   i0 = l1;
   i1 = 16u;
   i0 += i1;
   l2 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l4 = i0;
   if (i0) {goto B10;}
   i0 = 0u;
@@ -8345,6 +8669,7 @@ static void free(u32 p0) {
   goto B7;
   B10:;
   L11: 
+    EPOCH_CHECK;
     i0 = l2;
     l6 = i0;
     i0 = l4;
@@ -8352,7 +8677,7 @@ static void free(u32 p0) {
     i1 = 20u;
     i0 += i1;
     l2 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     l4 = i0;
     if (i0) {goto L11;}
     i0 = l5;
@@ -8360,75 +8685,75 @@ static void free(u32 p0) {
     i0 += i1;
     l2 = i0;
     i0 = l5;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
     l4 = i0;
     if (i0) {goto L11;}
   i0 = l6;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   B7:;
   i0 = l7;
   i0 = !(i0);
   if (i0) {goto B1;}
   i0 = l1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 28));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 28));
   l4 = i0;
   i1 = 2u;
   i0 <<= (i1 & 31);
   i1 = 3416u;
   i0 += i1;
   l2 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   i1 = l1;
   i0 = i0 != i1;
   if (i0) {goto B13;}
   i0 = l2;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l5;
   if (i0) {goto B12;}
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3116));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3116));
   i2 = 4294967294u;
   i3 = l4;
   i2 = I32_ROTL(i2, i3);
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3116), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3116), i1);
   goto B1;
   B13:;
   i0 = l7;
   i1 = 16u;
   i2 = 20u;
   i3 = l7;
-  i3 = i32_load(Z_envZ_memory, (u64)(i3 + 16));
+  i3 = i32_load(instance->Z_envZ_memory, (u64)(i3 + 16));
   i4 = l1;
   i3 = i3 == i4;
   i1 = i3 ? i1 : i2;
   i0 += i1;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l5;
   i0 = !(i0);
   if (i0) {goto B1;}
   B12:;
   i0 = l5;
   i1 = l7;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   i0 = l1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
   l2 = i0;
   i0 = !(i0);
   if (i0) {goto B14;}
   i0 = l5;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 16), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 16), i1);
   i0 = l2;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   B14:;
   i0 = l1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 20));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 20));
   l2 = i0;
   i0 = !(i0);
   if (i0) {goto B1;}
@@ -8436,14 +8761,14 @@ static void free(u32 p0) {
   i1 = 20u;
   i0 += i1;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l2;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   goto B1;
   B2:;
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
   l2 = i0;
   i1 = 3u;
   i0 &= i1;
@@ -8452,22 +8777,22 @@ static void free(u32 p0) {
   if (i0) {goto B1;}
   i0 = 0u;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3120), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3120), i1);
   i0 = l3;
   i1 = l2;
   i2 = 4294967294u;
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l1;
   i1 = p0;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l1;
   i1 = p0;
   i0 += i1;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   goto Bfunc;
   B1:;
   i0 = l3;
@@ -8475,7 +8800,7 @@ static void free(u32 p0) {
   i0 = i0 <= i1;
   if (i0) {goto B0;}
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
   l2 = i0;
   i1 = 1u;
   i0 &= i1;
@@ -8486,63 +8811,63 @@ static void free(u32 p0) {
   i0 &= i1;
   if (i0) {goto B16;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3136));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3136));
   i1 = l3;
   i0 = i0 != i1;
   if (i0) {goto B17;}
   i0 = 0u;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3136), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3136), i1);
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3124));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3124));
   i2 = p0;
   i1 += i2;
   p0 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3124), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3124), i1);
   i0 = l1;
   i1 = p0;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l1;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3132));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3132));
   i0 = i0 != i1;
   if (i0) {goto B0;}
   i0 = 0u;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3120), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3120), i1);
   i0 = 0u;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3132), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3132), i1);
   goto Bfunc;
   B17:;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3132));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3132));
   i1 = l3;
   i0 = i0 != i1;
   if (i0) {goto B18;}
   i0 = 0u;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3132), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3132), i1);
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3120));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3120));
   i2 = p0;
   i1 += i2;
   p0 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3120), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3120), i1);
   i0 = l1;
   i1 = p0;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l1;
   i1 = p0;
   i0 += i1;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   goto Bfunc;
   B18:;
   i0 = l2;
@@ -8556,10 +8881,10 @@ static void free(u32 p0) {
   i0 = i0 > i1;
   if (i0) {goto B20;}
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   l4 = i0;
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   l5 = i0;
   i1 = l2;
   i2 = 3u;
@@ -8573,7 +8898,7 @@ static void free(u32 p0) {
   i0 = i0 == i1;
   if (i0) {goto B21;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3128));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3128));
   i1 = l5;
   i0 = i0 > i1;
   B21:;
@@ -8583,12 +8908,12 @@ static void free(u32 p0) {
   if (i0) {goto B22;}
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3112));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3112));
   i2 = 4294967294u;
   i3 = l3;
   i2 = I32_ROTL(i2, i3);
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3112), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3112), i1);
   goto B19;
   B22:;
   i0 = l4;
@@ -8596,59 +8921,59 @@ static void free(u32 p0) {
   i0 = i0 == i1;
   if (i0) {goto B23;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3128));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3128));
   i1 = l4;
   i0 = i0 > i1;
   B23:;
   i0 = l5;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l4;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B19;
   B20:;
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 24));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 24));
   l7 = i0;
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   l5 = i0;
   i1 = l3;
   i0 = i0 == i1;
   if (i0) {goto B25;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3128));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3128));
   i1 = l3;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 8));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 8));
   l2 = i1;
   i0 = i0 > i1;
   if (i0) {goto B26;}
   i0 = l2;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 12));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 12));
   i1 = l3;
   i0 = i0 != i1;
   B26:;
   i0 = l2;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l5;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B24;
   B25:;
   i0 = l3;
   i1 = 20u;
   i0 += i1;
   l2 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l4 = i0;
   if (i0) {goto B27;}
   i0 = l3;
   i1 = 16u;
   i0 += i1;
   l2 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l4 = i0;
   if (i0) {goto B27;}
   i0 = 0u;
@@ -8656,6 +8981,7 @@ static void free(u32 p0) {
   goto B24;
   B27:;
   L28: 
+    EPOCH_CHECK;
     i0 = l2;
     l6 = i0;
     i0 = l4;
@@ -8663,7 +8989,7 @@ static void free(u32 p0) {
     i1 = 20u;
     i0 += i1;
     l2 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     l4 = i0;
     if (i0) {goto L28;}
     i0 = l5;
@@ -8671,75 +8997,75 @@ static void free(u32 p0) {
     i0 += i1;
     l2 = i0;
     i0 = l5;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
     l4 = i0;
     if (i0) {goto L28;}
   i0 = l6;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   B24:;
   i0 = l7;
   i0 = !(i0);
   if (i0) {goto B19;}
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 28));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 28));
   l4 = i0;
   i1 = 2u;
   i0 <<= (i1 & 31);
   i1 = 3416u;
   i0 += i1;
   l2 = i0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   i1 = l3;
   i0 = i0 != i1;
   if (i0) {goto B30;}
   i0 = l2;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l5;
   if (i0) {goto B29;}
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3116));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3116));
   i2 = 4294967294u;
   i3 = l4;
   i2 = I32_ROTL(i2, i3);
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3116), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3116), i1);
   goto B19;
   B30:;
   i0 = l7;
   i1 = 16u;
   i2 = 20u;
   i3 = l7;
-  i3 = i32_load(Z_envZ_memory, (u64)(i3 + 16));
+  i3 = i32_load(instance->Z_envZ_memory, (u64)(i3 + 16));
   i4 = l3;
   i3 = i3 == i4;
   i1 = i3 ? i1 : i2;
   i0 += i1;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l5;
   i0 = !(i0);
   if (i0) {goto B19;}
   B29:;
   i0 = l5;
   i1 = l7;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 16));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 16));
   l2 = i0;
   i0 = !(i0);
   if (i0) {goto B31;}
   i0 = l5;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 16), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 16), i1);
   i0 = l2;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   B31:;
   i0 = l3;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 20));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 20));
   l2 = i0;
   i0 = !(i0);
   if (i0) {goto B19;}
@@ -8747,46 +9073,46 @@ static void free(u32 p0) {
   i1 = 20u;
   i0 += i1;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l2;
   i1 = l5;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   B19:;
   i0 = l1;
   i1 = p0;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l1;
   i1 = p0;
   i0 += i1;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l1;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3132));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3132));
   i0 = i0 != i1;
   if (i0) {goto B15;}
   i0 = 0u;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3120), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3120), i1);
   goto Bfunc;
   B16:;
   i0 = l3;
   i1 = l2;
   i2 = 4294967294u;
   i1 &= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l1;
   i1 = p0;
   i2 = 1u;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = l1;
   i1 = p0;
   i0 += i1;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   B15:;
   i0 = p0;
   i1 = 255u;
@@ -8802,7 +9128,7 @@ static void free(u32 p0) {
   i0 += i1;
   p0 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3112));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3112));
   l4 = i0;
   i1 = 1u;
   i2 = l2;
@@ -8814,27 +9140,27 @@ static void free(u32 p0) {
   i1 = l4;
   i2 = l2;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3112), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3112), i1);
   i0 = p0;
   l2 = i0;
   goto B33;
   B34:;
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   l2 = i0;
   B33:;
   i0 = p0;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   i0 = l2;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l1;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l1;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto Bfunc;
   B32:;
   i0 = 0u;
@@ -8906,12 +9232,12 @@ static void free(u32 p0) {
   B35:;
   i0 = l1;
   j1 = 0ull;
-  i64_store(Z_envZ_memory, (u64)(i0 + 16), j1);
+  i64_store(instance->Z_envZ_memory, (u64)(i0 + 16), j1);
   i0 = l1;
   i1 = 28u;
   i0 += i1;
   i1 = l2;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l2;
   i1 = 2u;
   i0 <<= (i1 & 31);
@@ -8919,7 +9245,7 @@ static void free(u32 p0) {
   i0 += i1;
   l4 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3116));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3116));
   l5 = i0;
   i1 = 1u;
   i2 = l2;
@@ -8931,21 +9257,21 @@ static void free(u32 p0) {
   i1 = l5;
   i2 = l3;
   i1 |= i2;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3116), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3116), i1);
   i0 = l4;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l1;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l1;
   i1 = 24u;
   i0 += i1;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l1;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B36;
   B37:;
   i0 = p0;
@@ -8962,12 +9288,13 @@ static void free(u32 p0) {
   i0 <<= (i1 & 31);
   l2 = i0;
   i0 = l4;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l5 = i0;
   L39: 
+    EPOCH_CHECK;
     i0 = l5;
     l4 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
     i1 = 4294967288u;
     i0 &= i1;
     i1 = p0;
@@ -8989,59 +9316,60 @@ static void free(u32 p0) {
     i1 = 16u;
     i0 += i1;
     l3 = i0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     l5 = i0;
     if (i0) {goto L39;}
   i0 = l3;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l1;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l1;
   i1 = 24u;
   i0 += i1;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l1;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   goto B36;
   B38:;
   i0 = l4;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 8));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 8));
   p0 = i0;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l4;
   i1 = l1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   i0 = l1;
   i1 = 24u;
   i0 += i1;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l1;
   i1 = l4;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = l1;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   B36:;
   i0 = 0u;
   i1 = 0u;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 3144));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 3144));
   i2 = 4294967295u;
   i1 += i2;
   l1 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3144), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3144), i1);
   i0 = l1;
   if (i0) {goto B0;}
   i0 = 3568u;
   l1 = i0;
   L40: 
+    EPOCH_CHECK;
     i0 = l1;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
     p0 = i0;
     i1 = 8u;
     i0 += i1;
@@ -9050,22 +9378,25 @@ static void free(u32 p0) {
     if (i0) {goto L40;}
   i0 = 0u;
   i1 = 4294967295u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3144), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3144), i1);
   B0:;
   Bfunc:;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
 }
+#endif
 
-static u32 f52(u32 p0) {
+static u32 f52(hello_instance_t* instance, u32 p0) {
   u32 l1 = 0, l2 = 0, l3 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2;
-  i0 = f6();
+  i0 = f6(instance);
   l1 = i0;
-  i0 = (*Z_envZ_memory).pages;
+  i0 = (*instance->Z_envZ_memory).pages;
   l2 = i0;
   i0 = l1;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   l3 = i0;
   i1 = p0;
   i0 += i1;
@@ -9076,26 +9407,37 @@ static u32 f52(u32 p0) {
   i0 = i0 <= i1;
   if (i0) {goto B0;}
   i0 = p0;
-  i0 = (*Z_envZ_emscripten_resize_heapZ_ii)(i0);
+  i0 = (*Z_envZ_emscripten_resize_heapZ_ii)(instance, i0);
   if (i0) {goto B0;}
-  i0 = __errno_location();
+  i0 = __errno_location(instance);
   i1 = 48u;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = 4294967295u;
   goto Bfunc;
   B0:;
   i0 = l1;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l3;
   Bfunc:;
   FUNC_EPILOGUE;
   return i0;
 }
 
-static u32 f53(u32 p0, u32 p1, u32 p2) {
+#if HELLO_BULK_MEMORY
+/* memcpy, as a bulk-memory build of libc compiles it. */
+static u32 f53(hello_instance_t* instance, u32 p0, u32 p1, u32 p2) {
+  LEAF_PROLOGUE;
+  memory_copy(instance->Z_envZ_memory, p0, p1, p2);
+  LEAF_EPILOGUE;
+  return p0;
+}
+#else
+static u32 f53(hello_instance_t* instance, u32 p0, u32 p1, u32 p2) {
   u32 l3 = 0, l4 = 0, l5 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2;
   i0 = p2;
   i1 = 8192u;
@@ -9104,7 +9446,7 @@ static u32 f53(u32 p0, u32 p1, u32 p2) {
   i0 = p0;
   i1 = p1;
   i2 = p2;
-  i0 = (*Z_envZ_emscripten_memcpy_bigZ_iiii)(i0, i1, i2);
+  i0 = (*Z_envZ_emscripten_memcpy_bigZ_iiii)(instance, i0, i1, i2);
   i0 = p0;
   goto Bfunc;
   B0:;
@@ -9137,10 +9479,11 @@ static u32 f53(u32 p0, u32 p1, u32 p2) {
   i0 = p0;
   p2 = i0;
   L6: 
+    EPOCH_CHECK;
     i0 = p2;
     i1 = p1;
-    i1 = i32_load8_u(Z_envZ_memory, (u64)(i1));
-    i32_store8(Z_envZ_memory, (u64)(i0), i1);
+    i1 = i32_load8_u(instance->Z_envZ_memory, (u64)(i1));
+    i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = p1;
     i1 = 1u;
     i0 += i1;
@@ -9172,70 +9515,71 @@ static u32 f53(u32 p0, u32 p1, u32 p2) {
   i0 = i0 > i1;
   if (i0) {goto B7;}
   L8: 
+    EPOCH_CHECK;
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1));
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 4));
-    i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 4));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 8));
-    i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 8));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 12));
-    i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 12));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 16));
-    i32_store(Z_envZ_memory, (u64)(i0 + 16), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 16));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 16), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 20));
-    i32_store(Z_envZ_memory, (u64)(i0 + 20), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 20));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 20), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 24));
-    i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 24));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 28));
-    i32_store(Z_envZ_memory, (u64)(i0 + 28), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 28));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 28), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 32));
-    i32_store(Z_envZ_memory, (u64)(i0 + 32), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 32));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 32), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 36));
-    i32_store(Z_envZ_memory, (u64)(i0 + 36), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 36));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 36), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 40));
-    i32_store(Z_envZ_memory, (u64)(i0 + 40), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 40));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 40), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 44));
-    i32_store(Z_envZ_memory, (u64)(i0 + 44), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 44));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 44), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 48));
-    i32_store(Z_envZ_memory, (u64)(i0 + 48), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 48));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 48), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 52));
-    i32_store(Z_envZ_memory, (u64)(i0 + 52), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 52));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 52), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 56));
-    i32_store(Z_envZ_memory, (u64)(i0 + 56), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 56));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 56), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 60));
-    i32_store(Z_envZ_memory, (u64)(i0 + 60), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 60));
+    i32_store(instance->Z_envZ_memory, (u64)(i0 + 60), i1);
     i0 = p1;
     i1 = 64u;
     i0 += i1;
@@ -9253,10 +9597,11 @@ static u32 f53(u32 p0, u32 p1, u32 p2) {
   i0 = i0 >= i1;
   if (i0) {goto B1;}
   L9: 
+    EPOCH_CHECK;
     i0 = p2;
     i1 = p1;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1));
-    i32_store(Z_envZ_memory, (u64)(i0), i1);
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1));
+    i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = p1;
     i1 = 4u;
     i0 += i1;
@@ -9293,22 +9638,23 @@ static u32 f53(u32 p0, u32 p1, u32 p2) {
   i0 = p0;
   p2 = i0;
   L12: 
+    EPOCH_CHECK;
     i0 = p2;
     i1 = p1;
-    i1 = i32_load8_u(Z_envZ_memory, (u64)(i1));
-    i32_store8(Z_envZ_memory, (u64)(i0), i1);
+    i1 = i32_load8_u(instance->Z_envZ_memory, (u64)(i1));
+    i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load8_u(Z_envZ_memory, (u64)(i1 + 1));
-    i32_store8(Z_envZ_memory, (u64)(i0 + 1), i1);
+    i1 = i32_load8_u(instance->Z_envZ_memory, (u64)(i1 + 1));
+    i32_store8(instance->Z_envZ_memory, (u64)(i0 + 1), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load8_u(Z_envZ_memory, (u64)(i1 + 2));
-    i32_store8(Z_envZ_memory, (u64)(i0 + 2), i1);
+    i1 = i32_load8_u(instance->Z_envZ_memory, (u64)(i1 + 2));
+    i32_store8(instance->Z_envZ_memory, (u64)(i0 + 2), i1);
     i0 = p2;
     i1 = p1;
-    i1 = i32_load8_u(Z_envZ_memory, (u64)(i1 + 3));
-    i32_store8(Z_envZ_memory, (u64)(i0 + 3), i1);
+    i1 = i32_load8_u(instance->Z_envZ_memory, (u64)(i1 + 3));
+    i32_store8(instance->Z_envZ_memory, (u64)(i0 + 3), i1);
     i0 = p1;
     i1 = 4u;
     i0 += i1;
@@ -9326,10 +9672,11 @@ static u32 f53(u32 p0, u32 p1, u32 p2) {
   i0 = i0 >= i1;
   if (i0) {goto B13;}
   L14: 
+    EPOCH_CHECK;
     i0 = p2;
     i1 = p1;
-    i1 = i32_load8_u(Z_envZ_memory, (u64)(i1));
-    i32_store8(Z_envZ_memory, (u64)(i0), i1);
+    i1 = i32_load8_u(instance->Z_envZ_memory, (u64)(i1));
+    i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
     i0 = p1;
     i1 = 1u;
     i0 += i1;
@@ -9347,11 +9694,22 @@ static u32 f53(u32 p0, u32 p1, u32 p2) {
   FUNC_EPILOGUE;
   return i0;
 }
+#endif
 
-static u32 f54(u32 p0, u32 p1, u32 p2) {
+#if HELLO_BULK_MEMORY
+/* memset, as a bulk-memory build of libc compiles it. */
+static u32 f54(hello_instance_t* instance, u32 p0, u32 p1, u32 p2) {
+  LEAF_PROLOGUE;
+  memory_fill(instance->Z_envZ_memory, p0, p1, p2);
+  LEAF_EPILOGUE;
+  return p0;
+}
+#else
+static u32 f54(hello_instance_t* instance, u32 p0, u32 p1, u32 p2) {
   u32 l3 = 0, l4 = 0, l5 = 0;
   u64 l6 = 0;
-  FUNC_PROLOGUE;
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1, i2;
   u64 j0, j1;
   i0 = p2;
@@ -9364,10 +9722,10 @@ static u32 f54(u32 p0, u32 p1, u32 p2) {
   i1 = 4294967295u;
   i0 += i1;
   i1 = p1;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p2;
   i1 = 3u;
   i0 = i0 < i1;
@@ -9376,18 +9734,18 @@ static u32 f54(u32 p0, u32 p1, u32 p2) {
   i1 = 4294967294u;
   i0 += i1;
   i1 = p1;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  i32_store8(Z_envZ_memory, (u64)(i0 + 1), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0 + 1), i1);
   i0 = l3;
   i1 = 4294967293u;
   i0 += i1;
   i1 = p1;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  i32_store8(Z_envZ_memory, (u64)(i0 + 2), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0 + 2), i1);
   i0 = p2;
   i1 = 7u;
   i0 = i0 < i1;
@@ -9396,10 +9754,10 @@ static u32 f54(u32 p0, u32 p1, u32 p2) {
   i1 = 4294967292u;
   i0 += i1;
   i1 = p1;
-  i32_store8(Z_envZ_memory, (u64)(i0), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p0;
   i1 = p1;
-  i32_store8(Z_envZ_memory, (u64)(i0 + 3), i1);
+  i32_store8(instance->Z_envZ_memory, (u64)(i0 + 3), i1);
   i0 = p2;
   i1 = 9u;
   i0 = i0 < i1;
@@ -9419,7 +9777,7 @@ static u32 f54(u32 p0, u32 p1, u32 p2) {
   i2 = 16843009u;
   i1 *= i2;
   p1 = i1;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l3;
   i1 = p2;
   i2 = l4;
@@ -9432,63 +9790,63 @@ static u32 f54(u32 p0, u32 p1, u32 p2) {
   i1 = 4294967292u;
   i0 += i1;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l4;
   i1 = 9u;
   i0 = i0 < i1;
   if (i0) {goto B0;}
   i0 = l3;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 8), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 8), i1);
   i0 = l3;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 4), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 4), i1);
   i0 = p2;
   i1 = 4294967288u;
   i0 += i1;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p2;
   i1 = 4294967284u;
   i0 += i1;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l4;
   i1 = 25u;
   i0 = i0 < i1;
   if (i0) {goto B0;}
   i0 = l3;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 24), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 24), i1);
   i0 = l3;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 20), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 20), i1);
   i0 = l3;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 16), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 16), i1);
   i0 = l3;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 12), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 12), i1);
   i0 = p2;
   i1 = 4294967280u;
   i0 += i1;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p2;
   i1 = 4294967276u;
   i0 += i1;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p2;
   i1 = 4294967272u;
   i0 += i1;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = p2;
   i1 = 4294967268u;
   i0 += i1;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0), i1);
   i0 = l4;
   i1 = l3;
   i2 = 4u;
@@ -9514,18 +9872,19 @@ static u32 f54(u32 p0, u32 p1, u32 p2) {
   i0 += i1;
   p1 = i0;
   L1: 
+    EPOCH_CHECK;
     i0 = p1;
     j1 = l6;
-    i64_store(Z_envZ_memory, (u64)(i0 + 24), j1);
+    i64_store(instance->Z_envZ_memory, (u64)(i0 + 24), j1);
     i0 = p1;
     j1 = l6;
-    i64_store(Z_envZ_memory, (u64)(i0 + 16), j1);
+    i64_store(instance->Z_envZ_memory, (u64)(i0 + 16), j1);
     i0 = p1;
     j1 = l6;
-    i64_store(Z_envZ_memory, (u64)(i0 + 8), j1);
+    i64_store(instance->Z_envZ_memory, (u64)(i0 + 8), j1);
     i0 = p1;
     j1 = l6;
-    i64_store(Z_envZ_memory, (u64)(i0), j1);
+    i64_store(instance->Z_envZ_memory, (u64)(i0), j1);
     i0 = p1;
     i1 = 32u;
     i0 += i1;
@@ -9539,92 +9898,97 @@ static u32 f54(u32 p0, u32 p1, u32 p2) {
     if (i0) {goto L1;}
   B0:;
   i0 = p0;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
+#endif
 
-static void setThrew(u32 p0, u32 p1) {
-  FUNC_PROLOGUE;
+static void setThrew(hello_instance_t* instance, u32 p0, u32 p1) {
+  LEAF_PROLOGUE;
+  MEMORY_BASE;
   u32 i0, i1;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 3608));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 3608));
   if (i0) {goto B0;}
   i0 = 0u;
   i1 = p1;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3612), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3612), i1);
   i0 = 0u;
   i1 = p0;
-  i32_store(Z_envZ_memory, (u64)(i0 + 3608), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 3608), i1);
   B0:;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
 }
 
-static u32 fflush(u32 p0) {
+static u32 fflush(hello_instance_t* instance, u32 p0) {
   u32 l1 = 0, l2 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1;
   i0 = p0;
   i0 = !(i0);
   if (i0) {goto B1;}
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 76));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 76));
   i1 = 4294967295u;
   i0 = (u32)((s32)i0 > (s32)i1);
   if (i0) {goto B2;}
   i0 = p0;
-  i0 = f57(i0);
+  i0 = f57(instance, i0);
   goto Bfunc;
   B2:;
   i0 = p0;
-  i0 = f15(i0);
+  i0 = f15(instance, i0);
   l1 = i0;
   i0 = p0;
-  i0 = f57(i0);
+  i0 = f57(instance, i0);
   l2 = i0;
   i0 = l1;
   i0 = !(i0);
   if (i0) {goto B0;}
   i0 = p0;
-  f16(i0);
+  f16(instance, i0);
   i0 = l2;
   goto Bfunc;
   B1:;
   i0 = 0u;
   l2 = i0;
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 1752));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 1752));
   i0 = !(i0);
   if (i0) {goto B3;}
   i0 = 0u;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 1752));
-  i0 = fflush(i0);
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 1752));
+  i0 = fflush(instance, i0);
   l2 = i0;
   B3:;
-  i0 = f24();
-  i0 = i32_load(Z_envZ_memory, (u64)(i0));
+  i0 = f24(instance);
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0));
   p0 = i0;
   i0 = !(i0);
   if (i0) {goto B4;}
   L5: 
+    EPOCH_CHECK;
     i0 = 0u;
     l1 = i0;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 76));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 76));
     i1 = 0u;
     i0 = (u32)((s32)i0 < (s32)i1);
     if (i0) {goto B6;}
     i0 = p0;
-    i0 = f15(i0);
+    i0 = f15(instance, i0);
     l1 = i0;
     B6:;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 20));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 20));
     i1 = p0;
-    i1 = i32_load(Z_envZ_memory, (u64)(i1 + 28));
+    i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 28));
     i0 = i0 <= i1;
     if (i0) {goto B7;}
     i0 = p0;
-    i0 = f57(i0);
+    i0 = f57(instance, i0);
     i1 = l2;
     i0 |= i1;
     l2 = i0;
@@ -9633,14 +9997,14 @@ static u32 fflush(u32 p0) {
     i0 = !(i0);
     if (i0) {goto B8;}
     i0 = p0;
-    f16(i0);
+    f16(instance, i0);
     B8:;
     i0 = p0;
-    i0 = i32_load(Z_envZ_memory, (u64)(i0 + 56));
+    i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 56));
     p0 = i0;
     if (i0) {goto L5;}
   B4:;
-  f25();
+  f25(instance);
   B0:;
   i0 = l2;
   Bfunc:;
@@ -9648,34 +10012,36 @@ static u32 fflush(u32 p0) {
   return i0;
 }
 
-static u32 f57(u32 p0) {
+static u32 f57(hello_instance_t* instance, u32 p0) {
   u32 l1 = 0, l2 = 0;
   FUNC_PROLOGUE;
+  MEMORY_BASE;
+  EPOCH_CHECK;
   u32 i0, i1, i2, i3;
   u64 j0, j1;
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 20));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 20));
   i1 = p0;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 28));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 28));
   i0 = i0 <= i1;
   if (i0) {goto B0;}
   i0 = p0;
   i1 = 0u;
   i2 = 0u;
   i3 = p0;
-  i3 = i32_load(Z_envZ_memory, (u64)(i3 + 36));
-  i0 = CALL_INDIRECT((*Z_envZ_table), u32 (*)(u32, u32, u32), 0, i3, i0, i1, i2);
+  i3 = i32_load(instance->Z_envZ_memory, (u64)(i3 + 36));
+  i0 = CALL_INDIRECT_DIRECT((*instance->Z_envZ_table), u32 (*)(hello_instance_t*, u32, u32, u32), 0, i3, 2, f12, instance, i0, i1, i2);
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 20));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 20));
   if (i0) {goto B0;}
   i0 = 4294967295u;
   goto Bfunc;
   B0:;
   i0 = p0;
-  i0 = i32_load(Z_envZ_memory, (u64)(i0 + 4));
+  i0 = i32_load(instance->Z_envZ_memory, (u64)(i0 + 4));
   l1 = i0;
   i1 = p0;
-  i1 = i32_load(Z_envZ_memory, (u64)(i1 + 8));
+  i1 = i32_load(instance->Z_envZ_memory, (u64)(i1 + 8));
   l2 = i1;
   i0 = i0 >= i1;
   if (i0) {goto B1;}
@@ -9686,102 +10052,106 @@ static u32 f57(u32 p0) {
   j1 = (u64)(s64)(s32)(i1);
   i2 = 1u;
   i3 = p0;
-  i3 = i32_load(Z_envZ_memory, (u64)(i3 + 40));
-  j0 = CALL_INDIRECT((*Z_envZ_table), u64 (*)(u32, u64, u32), 3, i3, i0, j1, i2);
+  i3 = i32_load(instance->Z_envZ_memory, (u64)(i3 + 40));
+  j0 = CALL_INDIRECT_DIRECT((*instance->Z_envZ_table), u64 (*)(hello_instance_t*, u32, u64, u32), 3, i3, 3, f14, instance, i0, j1, i2);
   B1:;
   i0 = p0;
   i1 = 0u;
-  i32_store(Z_envZ_memory, (u64)(i0 + 28), i1);
+  i32_store(instance->Z_envZ_memory, (u64)(i0 + 28), i1);
   i0 = p0;
   j1 = 0ull;
-  i64_store(Z_envZ_memory, (u64)(i0 + 16), j1);
+  i64_store(instance->Z_envZ_memory, (u64)(i0 + 16), j1);
   i0 = p0;
   j1 = 0ull;
-  i64_store(Z_envZ_memory, (u64)(i0 + 4), j1);
+  i64_store(instance->Z_envZ_memory, (u64)(i0 + 4), j1);
   i0 = 0u;
   Bfunc:;
   FUNC_EPILOGUE;
   return i0;
 }
 
-static u32 stackSave(void) {
-  FUNC_PROLOGUE;
+static u32 stackSave(hello_instance_t* instance) {
+  LEAF_PROLOGUE;
   u32 i0;
-  i0 = g0;
-  FUNC_EPILOGUE;
+  i0 = instance->globals.g0;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u32 stackAlloc(u32 p0) {
+static u32 stackAlloc(hello_instance_t* instance, u32 p0) {
   u32 l1 = 0;
-  FUNC_PROLOGUE;
+  LEAF_PROLOGUE;
   u32 i0, i1;
-  i0 = g0;
+  i0 = instance->globals.g0;
   i1 = p0;
   i0 -= i1;
   i1 = 4294967280u;
   i0 &= i1;
   l1 = i0;
-  g0 = i0;
+  instance->globals.g0 = i0;
   i0 = l1;
-  FUNC_EPILOGUE;
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static void stackRestore(u32 p0) {
-  FUNC_PROLOGUE;
+static void stackRestore(hello_instance_t* instance, u32 p0) {
+  LEAF_PROLOGUE;
   u32 i0;
   i0 = p0;
-  g0 = i0;
-  FUNC_EPILOGUE;
+  instance->globals.g0 = i0;
+  LEAF_EPILOGUE;
 }
 
-static u32 __growWasmMemory(u32 p0) {
-  FUNC_PROLOGUE;
+static u32 __growWasmMemory(hello_instance_t* instance, u32 p0) {
+  LEAF_PROLOGUE;
   u32 i0;
   i0 = p0;
-  i0 = wasm_rt_grow_memory(Z_envZ_memory, i0);
-  FUNC_EPILOGUE;
+  i0 = wasm_rt_grow_memory(instance->Z_envZ_memory, i0);
+  LEAF_EPILOGUE;
   return i0;
 }
 
-static u32 dynCall_ii(u32 p0, u32 p1) {
+static u32 dynCall_ii(hello_instance_t* instance, u32 p0, u32 p1) {
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0, i1;
   i0 = p1;
   i1 = p0;
-  i0 = CALL_INDIRECT((*Z_envZ_table), u32 (*)(u32), 22, i1, i0);
+  i0 = CALL_INDIRECT_DIRECT((*instance->Z_envZ_table), u32 (*)(hello_instance_t*, u32), 22, i1, 1, f13, instance, i0);
   FUNC_EPILOGUE;
   return i0;
 }
 
-static u32 dynCall_iiii(u32 p0, u32 p1, u32 p2, u32 p3) {
+static u32 dynCall_iiii(hello_instance_t* instance, u32 p0, u32 p1, u32 p2, u32 p3) {
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0, i1, i2, i3;
   i0 = p1;
   i1 = p2;
   i2 = p3;
   i3 = p0;
-  i0 = CALL_INDIRECT((*Z_envZ_table), u32 (*)(u32, u32, u32), 23, i3, i0, i1, i2);
+  i0 = CALL_INDIRECT_DIRECT((*instance->Z_envZ_table), u32 (*)(hello_instance_t*, u32, u32, u32), 23, i3, 2, f12, instance, i0, i1, i2);
   FUNC_EPILOGUE;
   return i0;
 }
 
-static u64 f64_0(u32 p0, u32 p1, u64 p2, u32 p3) {
+static u64 f64_0(hello_instance_t* instance, u32 p0, u32 p1, u64 p2, u32 p3) {
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0, i2, i3;
   u64 j0, j1;
   i0 = p1;
   j1 = p2;
   i2 = p3;
   i3 = p0;
-  j0 = CALL_INDIRECT((*Z_envZ_table), u64 (*)(u32, u64, u32), 24, i3, i0, j1, i2);
+  j0 = CALL_INDIRECT_DIRECT((*instance->Z_envZ_table), u64 (*)(hello_instance_t*, u32, u64, u32), 24, i3, 3, f14, instance, i0, j1, i2);
   FUNC_EPILOGUE;
   return j0;
 }
 
-static u32 dynCall_iidiiii(u32 p0, u32 p1, f64 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
+static u32 dynCall_iidiiii(hello_instance_t* instance, u32 p0, u32 p1, f64 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0, i2, i3, i4, i5, i6;
   f64 d1;
   i0 = p1;
@@ -9791,24 +10161,26 @@ static u32 dynCall_iidiiii(u32 p0, u32 p1, f64 p2, u32 p3, u32 p4, u32 p5, u32 p
   i4 = p5;
   i5 = p6;
   i6 = p0;
-  i0 = CALL_INDIRECT((*Z_envZ_table), u32 (*)(u32, f64, u32, u32, u32, u32), 25, i6, i0, d1, i2, i3, i4, i5);
+  i0 = CALL_INDIRECT_DIRECT((*instance->Z_envZ_table), u32 (*)(hello_instance_t*, u32, f64, u32, u32, u32, u32), 25, i6, 4, f38, instance, i0, d1, i2, i3, i4, i5);
   FUNC_EPILOGUE;
   return i0;
 }
 
-static void dynCall_vii(u32 p0, u32 p1, u32 p2) {
+static void dynCall_vii(hello_instance_t* instance, u32 p0, u32 p1, u32 p2) {
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0, i1, i2;
   i0 = p1;
   i1 = p2;
   i2 = p0;
-  CALL_INDIRECT((*Z_envZ_table), void (*)(u32, u32), 26, i2, i0, i1);
+  CALL_INDIRECT_DIRECT((*instance->Z_envZ_table), void (*)(hello_instance_t*, u32, u32), 26, i2, 5, f39, instance, i0, i1);
   FUNC_EPILOGUE;
 }
 
-static u32 dynCall_jiji(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
+static u32 dynCall_jiji(hello_instance_t* instance, u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   u64 l5 = 0;
   FUNC_PROLOGUE;
+  EPOCH_CHECK;
   u32 i0, i1, i2, i3;
   u64 j0, j1, j2, j3, j4;
   i0 = p0;
@@ -9821,13 +10193,13 @@ static u32 dynCall_jiji(u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
   j3 <<= (j4 & 63);
   j2 |= j3;
   i3 = p4;
-  j0 = f64_0(i0, i1, j2, i3);
+  j0 = f64_0(instance, i0, i1, j2, i3);
   l5 = j0;
   j0 = l5;
   j1 = 32ull;
   j0 >>= (j1 & 63);
   i0 = (u32)(j0);
-  (*Z_envZ_setTempRet0Z_vi)(i0);
+  (*Z_envZ_setTempRet0Z_vi)(instance, i0);
   j0 = l5;
   i0 = (u32)(j0);
   FUNC_EPILOGUE;
@@ -10060,106 +10432,272 @@ static const u8 data_segment_data_2[] = {
   0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 };
 
-static void init_memory(void) {
-  memcpy(&((*Z_envZ_memory).data[1024u]), data_segment_data_0, 581);
-  memcpy(&((*Z_envZ_memory).data[1608u]), data_segment_data_1, 392);
-  memcpy(&((*Z_envZ_memory).data[2000u]), data_segment_data_2, 1616);
+#if HELLO_PREINIT
+#define data_segments preinit_segments
+#else
+static const wasm_rt_data_segment_t data_segments[] = {
+  {1024u, 581, data_segment_data_0},
+  {1608u, 392, data_segment_data_1},
+  {2000u, 1616, data_segment_data_2},
+};
+#endif
+
+/* The data segments laid out once per process by init(). Every instance
+ * maps it copy-on-write, so pages no instance writes to exist only once. */
+static wasm_rt_memory_snapshot_t data_image;
+
+static void init_data_image(void) {
+  wasm_rt_create_memory_image(&data_image, data_segments,
+                              sizeof(data_segments) / sizeof(data_segments[0]));
 }
 
-static void init_table(void) {
+static void init_memory(hello_instance_t* instance) {
+  wasm_rt_memory_t* memory = instance->Z_envZ_memory;
+#if HELLO_PREINIT
+  if (memory->pages < PREINIT_PAGES &&
+      wasm_rt_grow_memory(memory, PREINIT_PAGES - memory->pages) == (u32)-1)
+    TRAP(OOB);
+#endif
+  wasm_rt_map_memory_image(memory, &data_image);
+}
+
+static void init_table(hello_instance_t* instance) {
   uint32_t offset;
   offset = 1u;
-  (*Z_envZ_table).data[offset + 0] = (wasm_rt_elem_t){func_types[7], (wasm_rt_anyfunc_t)(&f13)};
-  (*Z_envZ_table).data[offset + 1] = (wasm_rt_elem_t){func_types[0], (wasm_rt_anyfunc_t)(&f12)};
-  (*Z_envZ_table).data[offset + 2] = (wasm_rt_elem_t){func_types[3], (wasm_rt_anyfunc_t)(&f14)};
-  (*Z_envZ_table).data[offset + 3] = (wasm_rt_elem_t){func_types[1], (wasm_rt_anyfunc_t)(&f38)};
-  (*Z_envZ_table).data[offset + 4] = (wasm_rt_elem_t){func_types[2], (wasm_rt_anyfunc_t)(&f39)};
+  (*instance->Z_envZ_table).data[offset + 0] = (wasm_rt_elem_t){func_types[7], (wasm_rt_anyfunc_t)(&f13)};
+  (*instance->Z_envZ_table).data[offset + 1] = (wasm_rt_elem_t){func_types[0], (wasm_rt_anyfunc_t)(&f12)};
+  (*instance->Z_envZ_table).data[offset + 2] = (wasm_rt_elem_t){func_types[3], (wasm_rt_anyfunc_t)(&f14)};
+  (*instance->Z_envZ_table).data[offset + 3] = (wasm_rt_elem_t){func_types[1], (wasm_rt_anyfunc_t)(&f38)};
+  (*instance->Z_envZ_table).data[offset + 4] = (wasm_rt_elem_t){func_types[2], (wasm_rt_anyfunc_t)(&f39)};
+}
+
+#if !HELLO_STATIC_LINK
+/* export: '__wasm_call_ctors' */
+void (*WASM_RT_ADD_PREFIX(Z___wasm_call_ctorsZ_vv))(hello_instance_t*);
+/* export: 'sayHello' */
+void (*WASM_RT_ADD_PREFIX(Z_sayHelloZ_vv))(hello_instance_t*);
+/* export: 'add' */
+f64 (*WASM_RT_ADD_PREFIX(Z_addZ_ddd))(hello_instance_t*, f64, f64);
+/* export: 'greet' */
+u32 (*WASM_RT_ADD_PREFIX(Z_greetZ_ii))(hello_instance_t*, u32);
+/* export: 'malloc' */
+u32 (*WASM_RT_ADD_PREFIX(Z_mallocZ_ii))(hello_instance_t*, u32);
+/* export: '__errno_location' */
+u32 (*WASM_RT_ADD_PREFIX(Z___errno_locationZ_iv))(hello_instance_t*);
+/* export: 'fflush' */
+u32 (*WASM_RT_ADD_PREFIX(Z_fflushZ_ii))(hello_instance_t*, u32);
+/* export: 'setThrew' */
+void (*WASM_RT_ADD_PREFIX(Z_setThrewZ_vii))(hello_instance_t*, u32, u32);
+/* export: 'free' */
+void (*WASM_RT_ADD_PREFIX(Z_freeZ_vi))(hello_instance_t*, u32);
+/* export: '__data_end' */
+u32* (*WASM_RT_ADD_PREFIX(Z___data_endZ_i))(hello_instance_t*);
+/* export: 'stackSave' */
+u32 (*WASM_RT_ADD_PREFIX(Z_stackSaveZ_iv))(hello_instance_t*);
+/* export: 'stackAlloc' */
+u32 (*WASM_RT_ADD_PREFIX(Z_stackAllocZ_ii))(hello_instance_t*, u32);
+/* export: 'stackRestore' */
+void (*WASM_RT_ADD_PREFIX(Z_stackRestoreZ_vi))(hello_instance_t*, u32);
+/* export: '__growWasmMemory' */
+u32 (*WASM_RT_ADD_PREFIX(Z___growWasmMemoryZ_ii))(hello_instance_t*, u32);
+/* export: 'dynCall_ii' */
+u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_iiZ_iii))(hello_instance_t*, u32, u32);
+/* export: 'dynCall_iiii' */
+u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_iiiiZ_iiiii))(hello_instance_t*, u32, u32, u32, u32);
+/* export: 'dynCall_jiji' */
+u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_jijiZ_iiiiii))(hello_instance_t*, u32, u32, u32, u32, u32);
+/* export: 'dynCall_iidiiii' */
+u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_iidiiiiZ_iiidiiii))(hello_instance_t*, u32, u32, f64, u32, u32, u32, u32);
+/* export: 'dynCall_vii' */
+void (*WASM_RT_ADD_PREFIX(Z_dynCall_viiZ_viii))(hello_instance_t*, u32, u32, u32);
+#endif
+
+static u32* get___data_end(hello_instance_t* instance) {
+  return &instance->globals.__data_end;
 }
 
 /* export: '__wasm_call_ctors' */
-void (*WASM_RT_ADD_PREFIX(Z___wasm_call_ctorsZ_vv))(void);
+EXPORT_LINKAGE void EXPORT_NAME(export___wasm_call_ctors, Z___wasm_call_ctorsZ_vv)(hello_instance_t* instance) {
+  __wasm_call_ctors(instance);
+  EXPORT_EPILOGUE;
+}
+
 /* export: 'sayHello' */
-void (*WASM_RT_ADD_PREFIX(Z_sayHelloZ_vv))(void);
+EXPORT_LINKAGE void EXPORT_NAME(export_sayHello, Z_sayHelloZ_vv)(hello_instance_t* instance) {
+  sayHello(instance);
+  EXPORT_EPILOGUE;
+}
+
 /* export: 'add' */
-f64 (*WASM_RT_ADD_PREFIX(Z_addZ_ddd))(f64, f64);
+EXPORT_LINKAGE f64 EXPORT_NAME(export_add, Z_addZ_ddd)(hello_instance_t* instance, f64 p0, f64 p1) {
+  f64 result = add(instance, p0, p1);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: 'greet' */
-u32 (*WASM_RT_ADD_PREFIX(Z_greetZ_ii))(u32);
+EXPORT_LINKAGE u32 EXPORT_NAME(export_greet, Z_greetZ_ii)(hello_instance_t* instance, u32 p0) {
+  u32 result = greet(instance, p0);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: 'malloc' */
-u32 (*WASM_RT_ADD_PREFIX(Z_mallocZ_ii))(u32);
+EXPORT_LINKAGE u32 EXPORT_NAME(export_malloc, Z_mallocZ_ii)(hello_instance_t* instance, u32 p0) {
+  u32 result = malloc(instance, p0);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: '__errno_location' */
-u32 (*WASM_RT_ADD_PREFIX(Z___errno_locationZ_iv))(void);
+EXPORT_LINKAGE u32 EXPORT_NAME(export___errno_location, Z___errno_locationZ_iv)(hello_instance_t* instance) {
+  u32 result = __errno_location(instance);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: 'fflush' */
-u32 (*WASM_RT_ADD_PREFIX(Z_fflushZ_ii))(u32);
+EXPORT_LINKAGE u32 EXPORT_NAME(export_fflush, Z_fflushZ_ii)(hello_instance_t* instance, u32 p0) {
+  u32 result = fflush(instance, p0);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: 'setThrew' */
-void (*WASM_RT_ADD_PREFIX(Z_setThrewZ_vii))(u32, u32);
+EXPORT_LINKAGE void EXPORT_NAME(export_setThrew, Z_setThrewZ_vii)(hello_instance_t* instance, u32 p0, u32 p1) {
+  setThrew(instance, p0, p1);
+  EXPORT_EPILOGUE;
+}
+
 /* export: 'free' */
-void (*WASM_RT_ADD_PREFIX(Z_freeZ_vi))(u32);
+EXPORT_LINKAGE void EXPORT_NAME(export_free, Z_freeZ_vi)(hello_instance_t* instance, u32 p0) {
+  free(instance, p0);
+  EXPORT_EPILOGUE;
+}
+
 /* export: '__data_end' */
-u32 (*WASM_RT_ADD_PREFIX(Z___data_endZ_i));
+EXPORT_LINKAGE u32* EXPORT_NAME(export_get___data_end, Z___data_endZ_i)(hello_instance_t* instance) {
+  u32* result = get___data_end(instance);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: 'stackSave' */
-u32 (*WASM_RT_ADD_PREFIX(Z_stackSaveZ_iv))(void);
+EXPORT_LINKAGE u32 EXPORT_NAME(export_stackSave, Z_stackSaveZ_iv)(hello_instance_t* instance) {
+  u32 result = stackSave(instance);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: 'stackAlloc' */
-u32 (*WASM_RT_ADD_PREFIX(Z_stackAllocZ_ii))(u32);
+EXPORT_LINKAGE u32 EXPORT_NAME(export_stackAlloc, Z_stackAllocZ_ii)(hello_instance_t* instance, u32 p0) {
+  u32 result = stackAlloc(instance, p0);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: 'stackRestore' */
-void (*WASM_RT_ADD_PREFIX(Z_stackRestoreZ_vi))(u32);
+EXPORT_LINKAGE void EXPORT_NAME(export_stackRestore, Z_stackRestoreZ_vi)(hello_instance_t* instance, u32 p0) {
+  stackRestore(instance, p0);
+  EXPORT_EPILOGUE;
+}
+
 /* export: '__growWasmMemory' */
-u32 (*WASM_RT_ADD_PREFIX(Z___growWasmMemoryZ_ii))(u32);
+EXPORT_LINKAGE u32 EXPORT_NAME(export___growWasmMemory, Z___growWasmMemoryZ_ii)(hello_instance_t* instance, u32 p0) {
+  u32 result = __growWasmMemory(instance, p0);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: 'dynCall_ii' */
-u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_iiZ_iii))(u32, u32);
+EXPORT_LINKAGE u32 EXPORT_NAME(export_dynCall_ii, Z_dynCall_iiZ_iii)(hello_instance_t* instance, u32 p0, u32 p1) {
+  u32 result = dynCall_ii(instance, p0, p1);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: 'dynCall_iiii' */
-u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_iiiiZ_iiiii))(u32, u32, u32, u32);
+EXPORT_LINKAGE u32 EXPORT_NAME(export_dynCall_iiii, Z_dynCall_iiiiZ_iiiii)(hello_instance_t* instance, u32 p0, u32 p1, u32 p2, u32 p3) {
+  u32 result = dynCall_iiii(instance, p0, p1, p2, p3);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: 'dynCall_jiji' */
-u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_jijiZ_iiiiii))(u32, u32, u32, u32, u32);
+EXPORT_LINKAGE u32 EXPORT_NAME(export_dynCall_jiji, Z_dynCall_jijiZ_iiiiii)(hello_instance_t* instance, u32 p0, u32 p1, u32 p2, u32 p3, u32 p4) {
+  u32 result = dynCall_jiji(instance, p0, p1, p2, p3, p4);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: 'dynCall_iidiiii' */
-u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_iidiiiiZ_iiidiiii))(u32, u32, f64, u32, u32, u32, u32);
+EXPORT_LINKAGE u32 EXPORT_NAME(export_dynCall_iidiiii, Z_dynCall_iidiiiiZ_iiidiiii)(hello_instance_t* instance, u32 p0, u32 p1, f64 p2, u32 p3, u32 p4, u32 p5, u32 p6) {
+  u32 result = dynCall_iidiiii(instance, p0, p1, p2, p3, p4, p5, p6);
+  EXPORT_EPILOGUE;
+  return result;
+}
+
 /* export: 'dynCall_vii' */
-void (*WASM_RT_ADD_PREFIX(Z_dynCall_viiZ_viii))(u32, u32, u32);
+EXPORT_LINKAGE void EXPORT_NAME(export_dynCall_vii, Z_dynCall_viiZ_viii)(hello_instance_t* instance, u32 p0, u32 p1, u32 p2) {
+  dynCall_vii(instance, p0, p1, p2);
+  EXPORT_EPILOGUE;
+}
 
 static void init_exports(void) {
+#if !HELLO_STATIC_LINK
   /* export: '__wasm_call_ctors' */
-  WASM_RT_ADD_PREFIX(Z___wasm_call_ctorsZ_vv) = (&__wasm_call_ctors);
+  WASM_RT_ADD_PREFIX(Z___wasm_call_ctorsZ_vv) = (&export___wasm_call_ctors);
   /* export: 'sayHello' */
-  WASM_RT_ADD_PREFIX(Z_sayHelloZ_vv) = (&sayHello);
+  WASM_RT_ADD_PREFIX(Z_sayHelloZ_vv) = (&export_sayHello);
   /* export: 'add' */
-  WASM_RT_ADD_PREFIX(Z_addZ_ddd) = (&add);
+  WASM_RT_ADD_PREFIX(Z_addZ_ddd) = (&export_add);
   /* export: 'greet' */
-  WASM_RT_ADD_PREFIX(Z_greetZ_ii) = (&greet);
+  WASM_RT_ADD_PREFIX(Z_greetZ_ii) = (&export_greet);
   /* export: 'malloc' */
-  WASM_RT_ADD_PREFIX(Z_mallocZ_ii) = (&malloc);
+  WASM_RT_ADD_PREFIX(Z_mallocZ_ii) = (&export_malloc);
   /* export: '__errno_location' */
-  WASM_RT_ADD_PREFIX(Z___errno_locationZ_iv) = (&__errno_location);
+  WASM_RT_ADD_PREFIX(Z___errno_locationZ_iv) = (&export___errno_location);
   /* export: 'fflush' */
-  WASM_RT_ADD_PREFIX(Z_fflushZ_ii) = (&fflush);
+  WASM_RT_ADD_PREFIX(Z_fflushZ_ii) = (&export_fflush);
   /* export: 'setThrew' */
-  WASM_RT_ADD_PREFIX(Z_setThrewZ_vii) = (&setThrew);
+  WASM_RT_ADD_PREFIX(Z_setThrewZ_vii) = (&export_setThrew);
   /* export: 'free' */
-  WASM_RT_ADD_PREFIX(Z_freeZ_vi) = (&free);
+  WASM_RT_ADD_PREFIX(Z_freeZ_vi) = (&export_free);
   /* export: '__data_end' */
-  WASM_RT_ADD_PREFIX(Z___data_endZ_i) = (&__data_end);
+  WASM_RT_ADD_PREFIX(Z___data_endZ_i) = (&export_get___data_end);
   /* export: 'stackSave' */
-  WASM_RT_ADD_PREFIX(Z_stackSaveZ_iv) = (&stackSave);
+  WASM_RT_ADD_PREFIX(Z_stackSaveZ_iv) = (&export_stackSave);
   /* export: 'stackAlloc' */
-  WASM_RT_ADD_PREFIX(Z_stackAllocZ_ii) = (&stackAlloc);
+  WASM_RT_ADD_PREFIX(Z_stackAllocZ_ii) = (&export_stackAlloc);
   /* export: 'stackRestore' */
-  WASM_RT_ADD_PREFIX(Z_stackRestoreZ_vi) = (&stackRestore);
+  WASM_RT_ADD_PREFIX(Z_stackRestoreZ_vi) = (&export_stackRestore);
   /* export: '__growWasmMemory' */
-  WASM_RT_ADD_PREFIX(Z___growWasmMemoryZ_ii) = (&__growWasmMemory);
+  WASM_RT_ADD_PREFIX(Z___growWasmMemoryZ_ii) = (&export___growWasmMemory);
   /* export: 'dynCall_ii' */
-  WASM_RT_ADD_PREFIX(Z_dynCall_iiZ_iii) = (&dynCall_ii);
+  WASM_RT_ADD_PREFIX(Z_dynCall_iiZ_iii) = (&export_dynCall_ii);
   /* export: 'dynCall_iiii' */
-  WASM_RT_ADD_PREFIX(Z_dynCall_iiiiZ_iiiii) = (&dynCall_iiii);
+  WASM_RT_ADD_PREFIX(Z_dynCall_iiiiZ_iiiii) = (&export_dynCall_iiii);
   /* export: 'dynCall_jiji' */
-  WASM_RT_ADD_PREFIX(Z_dynCall_jijiZ_iiiiii) = (&dynCall_jiji);
+  WASM_RT_ADD_PREFIX(Z_dynCall_jijiZ_iiiiii) = (&export_dynCall_jiji);
   /* export: 'dynCall_iidiiii' */
-  WASM_RT_ADD_PREFIX(Z_dynCall_iidiiiiZ_iiidiiii) = (&dynCall_iidiiii);
+  WASM_RT_ADD_PREFIX(Z_dynCall_iidiiiiZ_iiidiiii) = (&export_dynCall_iidiiii);
   /* export: 'dynCall_vii' */
-  WASM_RT_ADD_PREFIX(Z_dynCall_viiZ_viii) = (&dynCall_vii);
+  WASM_RT_ADD_PREFIX(Z_dynCall_viiZ_viii) = (&export_dynCall_vii);
+#endif
 }
 
 void WASM_RT_ADD_PREFIX(init)(void) {
-  init_func_types();
-  init_globals();
-  init_memory();
-  init_table();
+  init_data_image();
   init_exports();
 }
+
+void WASM_RT_ADD_PREFIX(instantiate)(hello_instance_t* instance,
+                                     wasm_rt_memory_t* memory,
+                                     wasm_rt_table_t* table) {
+  instance->Z_envZ_memory = memory;
+  instance->Z_envZ_table = table;
+  instance->epoch_deadline = UINT64_MAX;
+  init_globals(instance);
+  init_memory(instance);
+  init_table(instance);
+}
@@ -16,6 +16,69 @@ extern "C" {
 #define WASM_RT_PASTE(x, y) WASM_RT_PASTE_(x, y)
 #define WASM_RT_ADD_PREFIX(x) WASM_RT_PASTE(WASM_RT_MODULE_PREFIX, x)
 
+/* When set, the data segments are replaced by the memory image dumped by
+ * hello-preinit (see hello-preinit.inc), in which the constructors have
+ * already run. */
+#ifndef HELLO_PREINIT
+#define HELLO_PREINIT 0
+#endif
+
+/* When set, the embedder promises never to change the table after
+ * `instantiate`, and indirect calls that can only reach one function compare
+ * just the index before calling it directly. */
+#ifndef HELLO_IMMUTABLE_TABLE
+#define HELLO_IMMUTABLE_TABLE 0
+#endif
+
+/* When set, libc's memcpy and memset are replaced by the memory.copy and
+ * memory.fill they compile to in a bulk-memory build, so large copies no
+ * longer leave the module through `emscripten_memcpy_big`. */
+#ifndef HELLO_BULK_MEMORY
+#define HELLO_BULK_MEMORY 0
+#endif
+
+/* When set, malloc and free are not part of the module but imported from
+ * 'env', as when libc is linked without an allocator; the embedder supplies
+ * them (hello-host.c uses a per-request bump arena). */
+#ifndef HELLO_ARENA_MALLOC
+#define HELLO_ARENA_MALLOC 0
+#endif
+
+/* When set, the code is specialized for a memory created with exactly
+ * HELLO_FIXED_MEMORY_PAGES pages as both its initial and maximum size, as
+ * hello.js does; the embedder must not pass any other. Without guard pages,
+ * addresses are then masked into the memory instead of checked, which needs
+ * WASM_RT_MEMORY_PADDING of at least 8. */
+#ifndef HELLO_FIXED_MEMORY
+#define HELLO_FIXED_MEMORY 0
+#endif
+/* INITIAL_TOTAL_MEMORY / WASM_PAGE_SIZE in hello.js; a power of two. */
+#define HELLO_FIXED_MEMORY_PAGES 256u
+#define HELLO_FIXED_MEMORY_SIZE (HELLO_FIXED_MEMORY_PAGES * 65536u)
+
+/* When set, two hand specializations of the generated code apply: `add`
+ * keeps its arguments in C locals instead of shadow-stack slots, and malloc
+ * no longer moves `g0` for a frame it never writes. Code still sees the same
+ * values; only the dead bytes below `g0` differ. nativebuild checks that the
+ * code they were derived from is unchanged. */
+#ifndef HELLO_PROMOTE_SLOTS
+#define HELLO_PROMOTE_SLOTS 0
+#endif
+
+/* When set, imports and exports are plain external functions resolved at
+ * link time rather than function pointers filled in at startup, so calls
+ * across the boundary are direct and LTO can inline them. Imports can then
+ * no longer be replaced at run time. */
+#ifndef HELLO_STATIC_LINK
+#define HELLO_STATIC_LINK 0
+#endif
+
+/* When set, loops and calls check `epoch_deadline` so that long-running
+ * guest code can be interrupted from another thread. */
+#ifndef HELLO_EPOCH_INTERRUPT
+#define HELLO_EPOCH_INTERRUPT 0
+#endif
+
 /* TODO(binji): only use stdint.h types in header */
 typedef uint8_t u8;
 typedef int8_t s8;
@@ -28,63 +91,164 @@ typedef int64_t s64;
 typedef float f32;
 typedef double f64;
 
+/* The module's globals. Kept together so an embedder can save and restore
+ * them with a plain struct copy. */
+typedef struct hello_globals_t {
+  /* global 0: stack pointer */
+  u32 g0;
+  /* export: '__data_end' */
+  u32 __data_end;
+} hello_globals_t;
+
+/* All mutable state of one instance of the module. The embedder owns the
+ * storage; any number of instances can live in one process as long as each
+ * one is only entered by one thread at a time. */
+typedef struct hello_instance_t {
+  /* import: 'env' 'memory' */
+  wasm_rt_memory_t* Z_envZ_memory;
+  /* import: 'env' 'table' */
+  wasm_rt_table_t* Z_envZ_table;
+  hello_globals_t globals;
+  /* Guest code built with HELLO_EPOCH_INTERRUPT stops at the next loop header
+   * or call once `wasm_rt_epoch` reaches this; UINT64_MAX never does. */
+  u64 epoch_deadline;
+  /* If set, called whenever an export returns normally, e.g. to flush output
+   * the imports buffered during the call. */
+  void (*export_return)(struct hello_instance_t* instance);
+  /* Opaque embedder state; the module never touches it. Imports receive the
+   * instance and can find their own per-instance data here. */
+  void* host;
+} hello_instance_t;
+
+/* Process-wide setup (export table, shared data segment image). Call once
+ * before the first `instantiate`. */
 extern void WASM_RT_ADD_PREFIX(init)(void);
+/* Initialize the globals of `instance` and the data and element segments of
+ * its memory and table. With HELLO_PREINIT the memory and globals are left
+ * as they were after `__wasm_call_ctors`, which must not be called again. */
+extern void WASM_RT_ADD_PREFIX(instantiate)(hello_instance_t* instance,
+                                            wasm_rt_memory_t* memory,
+                                            wasm_rt_table_t* table);
 
+#if HELLO_STATIC_LINK
 /* import: 'wasi_unstable' 'fd_write' */
-extern u32 (*Z_wasi_unstableZ_fd_writeZ_iiiii)(u32, u32, u32, u32);
+extern u32 Z_wasi_unstableZ_fd_writeZ_iiiii(hello_instance_t*, u32, u32, u32, u32);
 /* import: 'env' '__lock' */
-extern void (*Z_envZ___lockZ_vi)(u32);
+extern void Z_envZ___lockZ_vi(hello_instance_t*, u32);
 /* import: 'env' '__unlock' */
-extern void (*Z_envZ___unlockZ_vi)(u32);
+extern void Z_envZ___unlockZ_vi(hello_instance_t*, u32);
 /* import: 'env' 'emscripten_resize_heap' */
-extern u32 (*Z_envZ_emscripten_resize_heapZ_ii)(u32);
+extern u32 Z_envZ_emscripten_resize_heapZ_ii(hello_instance_t*, u32);
 /* import: 'env' 'emscripten_memcpy_big' */
-extern u32 (*Z_envZ_emscripten_memcpy_bigZ_iiii)(u32, u32, u32);
+extern u32 Z_envZ_emscripten_memcpy_bigZ_iiii(hello_instance_t*, u32, u32, u32);
 /* import: 'env' 'setTempRet0' */
-extern void (*Z_envZ_setTempRet0Z_vi)(u32);
-/* import: 'env' 'memory' */
-extern wasm_rt_memory_t (*Z_envZ_memory);
-/* import: 'env' 'table' */
-extern wasm_rt_table_t (*Z_envZ_table);
+extern void Z_envZ_setTempRet0Z_vi(hello_instance_t*, u32);
+#if HELLO_ARENA_MALLOC
+/* import: 'env' 'malloc' */
+extern u32 Z_envZ_mallocZ_ii(hello_instance_t*, u32);
+/* import: 'env' 'free' */
+extern void Z_envZ_freeZ_vi(hello_instance_t*, u32);
+#endif
+#else
+/* import: 'wasi_unstable' 'fd_write' */
+extern u32 (*Z_wasi_unstableZ_fd_writeZ_iiiii)(hello_instance_t*, u32, u32, u32, u32);
+/* import: 'env' '__lock' */
+extern void (*Z_envZ___lockZ_vi)(hello_instance_t*, u32);
+/* import: 'env' '__unlock' */
+extern void (*Z_envZ___unlockZ_vi)(hello_instance_t*, u32);
+/* import: 'env' 'emscripten_resize_heap' */
+extern u32 (*Z_envZ_emscripten_resize_heapZ_ii)(hello_instance_t*, u32);
+/* import: 'env' 'emscripten_memcpy_big' */
+extern u32 (*Z_envZ_emscripten_memcpy_bigZ_iiii)(hello_instance_t*, u32, u32, u32);
+/* import: 'env' 'setTempRet0' */
+extern void (*Z_envZ_setTempRet0Z_vi)(hello_instance_t*, u32);
+#if HELLO_ARENA_MALLOC
+/* import: 'env' 'malloc' */
+extern u32 (*Z_envZ_mallocZ_ii)(hello_instance_t*, u32);
+/* import: 'env' 'free' */
+extern void (*Z_envZ_freeZ_vi)(hello_instance_t*, u32);
+#endif
+#endif
 
+#if HELLO_STATIC_LINK
 /* export: '__wasm_call_ctors' */
-extern void (*WASM_RT_ADD_PREFIX(Z___wasm_call_ctorsZ_vv))(void);
+extern void WASM_RT_ADD_PREFIX(Z___wasm_call_ctorsZ_vv)(hello_instance_t*);
 /* export: 'sayHello' */
-extern void (*WASM_RT_ADD_PREFIX(Z_sayHelloZ_vv))(void);
+extern void WASM_RT_ADD_PREFIX(Z_sayHelloZ_vv)(hello_instance_t*);
 /* export: 'add' */
-extern f64 (*WASM_RT_ADD_PREFIX(Z_addZ_ddd))(f64, f64);
+extern f64 WASM_RT_ADD_PREFIX(Z_addZ_ddd)(hello_instance_t*, f64, f64);
 /* export: 'greet' */
-extern u32 (*WASM_RT_ADD_PREFIX(Z_greetZ_ii))(u32);
+extern u32 WASM_RT_ADD_PREFIX(Z_greetZ_ii)(hello_instance_t*, u32);
 /* export: 'malloc' */
-extern u32 (*WASM_RT_ADD_PREFIX(Z_mallocZ_ii))(u32);
+extern u32 WASM_RT_ADD_PREFIX(Z_mallocZ_ii)(hello_instance_t*, u32);
 /* export: '__errno_location' */
-extern u32 (*WASM_RT_ADD_PREFIX(Z___errno_locationZ_iv))(void);
+extern u32 WASM_RT_ADD_PREFIX(Z___errno_locationZ_iv)(hello_instance_t*);
 /* export: 'fflush' */
-extern u32 (*WASM_RT_ADD_PREFIX(Z_fflushZ_ii))(u32);
+extern u32 WASM_RT_ADD_PREFIX(Z_fflushZ_ii)(hello_instance_t*, u32);
 /* export: 'setThrew' */
-extern void (*WASM_RT_ADD_PREFIX(Z_setThrewZ_vii))(u32, u32);
+extern void WASM_RT_ADD_PREFIX(Z_setThrewZ_vii)(hello_instance_t*, u32, u32);
 /* export: 'free' */
-extern void (*WASM_RT_ADD_PREFIX(Z_freeZ_vi))(u32);
+extern void WASM_RT_ADD_PREFIX(Z_freeZ_vi)(hello_instance_t*, u32);
 /* export: '__data_end' */
-extern u32 (*WASM_RT_ADD_PREFIX(Z___data_endZ_i));
+extern u32* WASM_RT_ADD_PREFIX(Z___data_endZ_i)(hello_instance_t*);
 /* export: 'stackSave' */
-extern u32 (*WASM_RT_ADD_PREFIX(Z_stackSaveZ_iv))(void);
+extern u32 WASM_RT_ADD_PREFIX(Z_stackSaveZ_iv)(hello_instance_t*);
 /* export: 'stackAlloc' */
-extern u32 (*WASM_RT_ADD_PREFIX(Z_stackAllocZ_ii))(u32);
+extern u32 WASM_RT_ADD_PREFIX(Z_stackAllocZ_ii)(hello_instance_t*, u32);
 /* export: 'stackRestore' */
-extern void (*WASM_RT_ADD_PREFIX(Z_stackRestoreZ_vi))(u32);
+extern void WASM_RT_ADD_PREFIX(Z_stackRestoreZ_vi)(hello_instance_t*, u32);
 /* export: '__growWasmMemory' */
-extern u32 (*WASM_RT_ADD_PREFIX(Z___growWasmMemoryZ_ii))(u32);
+extern u32 WASM_RT_ADD_PREFIX(Z___growWasmMemoryZ_ii)(hello_instance_t*, u32);
 /* export: 'dynCall_ii' */
-extern u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_iiZ_iii))(u32, u32);
+extern u32 WASM_RT_ADD_PREFIX(Z_dynCall_iiZ_iii)(hello_instance_t*, u32, u32);
 /* export: 'dynCall_iiii' */
-extern u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_iiiiZ_iiiii))(u32, u32, u32, u32);
+extern u32 WASM_RT_ADD_PREFIX(Z_dynCall_iiiiZ_iiiii)(hello_instance_t*, u32, u32, u32, u32);
 /* export: 'dynCall_jiji' */
-extern u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_jijiZ_iiiiii))(u32, u32, u32, u32, u32);
+extern u32 WASM_RT_ADD_PREFIX(Z_dynCall_jijiZ_iiiiii)(hello_instance_t*, u32, u32, u32, u32, u32);
 /* export: 'dynCall_iidiiii' */
-extern u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_iidiiiiZ_iiidiiii))(u32, u32, f64, u32, u32, u32, u32);
+extern u32 WASM_RT_ADD_PREFIX(Z_dynCall_iidiiiiZ_iiidiiii)(hello_instance_t*, u32, u32, f64, u32, u32, u32, u32);
 /* export: 'dynCall_vii' */
-extern void (*WASM_RT_ADD_PREFIX(Z_dynCall_viiZ_viii))(u32, u32, u32);
+extern void WASM_RT_ADD_PREFIX(Z_dynCall_viiZ_viii)(hello_instance_t*, u32, u32, u32);
+#else
+/* export: '__wasm_call_ctors' */
+extern void (*WASM_RT_ADD_PREFIX(Z___wasm_call_ctorsZ_vv))(hello_instance_t*);
+/* export: 'sayHello' */
+extern void (*WASM_RT_ADD_PREFIX(Z_sayHelloZ_vv))(hello_instance_t*);
+/* export: 'add' */
+extern f64 (*WASM_RT_ADD_PREFIX(Z_addZ_ddd))(hello_instance_t*, f64, f64);
+/* export: 'greet' */
+extern u32 (*WASM_RT_ADD_PREFIX(Z_greetZ_ii))(hello_instance_t*, u32);
+/* export: 'malloc' */
+extern u32 (*WASM_RT_ADD_PREFIX(Z_mallocZ_ii))(hello_instance_t*, u32);
+/* export: '__errno_location' */
+extern u32 (*WASM_RT_ADD_PREFIX(Z___errno_locationZ_iv))(hello_instance_t*);
+/* export: 'fflush' */
+extern u32 (*WASM_RT_ADD_PREFIX(Z_fflushZ_ii))(hello_instance_t*, u32);
+/* export: 'setThrew' */
+extern void (*WASM_RT_ADD_PREFIX(Z_setThrewZ_vii))(hello_instance_t*, u32, u32);
+/* export: 'free' */
+extern void (*WASM_RT_ADD_PREFIX(Z_freeZ_vi))(hello_instance_t*, u32);
+/* export: '__data_end' */
+extern u32* (*WASM_RT_ADD_PREFIX(Z___data_endZ_i))(hello_instance_t*);
+/* export: 'stackSave' */
+extern u32 (*WASM_RT_ADD_PREFIX(Z_stackSaveZ_iv))(hello_instance_t*);
+/* export: 'stackAlloc' */
+extern u32 (*WASM_RT_ADD_PREFIX(Z_stackAllocZ_ii))(hello_instance_t*, u32);
+/* export: 'stackRestore' */
+extern void (*WASM_RT_ADD_PREFIX(Z_stackRestoreZ_vi))(hello_instance_t*, u32);
+/* export: '__growWasmMemory' */
+extern u32 (*WASM_RT_ADD_PREFIX(Z___growWasmMemoryZ_ii))(hello_instance_t*, u32);
+/* export: 'dynCall_ii' */
+extern u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_iiZ_iii))(hello_instance_t*, u32, u32);
+/* export: 'dynCall_iiii' */
+extern u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_iiiiZ_iiiii))(hello_instance_t*, u32, u32, u32, u32);
+/* export: 'dynCall_jiji' */
+extern u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_jijiZ_iiiiii))(hello_instance_t*, u32, u32, u32, u32, u32);
+/* export: 'dynCall_iidiiii' */
+extern u32 (*WASM_RT_ADD_PREFIX(Z_dynCall_iidiiiiZ_iiidiiii))(hello_instance_t*, u32, u32, f64, u32, u32, u32, u32);
+/* export: 'dynCall_vii' */
+extern void (*WASM_RT_ADD_PREFIX(Z_dynCall_viiZ_viii))(hello_instance_t*, u32, u32, u32);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,336 @@
+#include "hello-uring.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(SYS_io_uring_setup)
+#include <linux/io_uring.h>
+#define HELLO_HAVE_URING 1
+#else
+#define HELLO_HAVE_URING 0
+#endif
+
+#if HELLO_HAVE_URING
+
+#define URING_ENTRIES 64u
+
+struct hello_uring_t {
+  pthread_mutex_t mutex;
+  int fd;
+  void* sq_ring;
+  size_t sq_ring_size;
+  void* cq_ring;
+  size_t cq_ring_size;
+  struct io_uring_sqe* sqes;
+  unsigned* sq_tail;
+  unsigned* sq_array;
+  unsigned sq_mask;
+  unsigned sq_entries;
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  unsigned cq_mask;
+  unsigned cq_entries;
+  struct io_uring_cqe* cqes;
+  /* Queued in the SQ but not yet handed to the kernel. */
+  unsigned unsubmitted;
+  /* Queued or submitted, and not yet reaped. */
+  unsigned inflight;
+  /* Every request not yet reaped, oldest first; only those that are
+   * `started` have an SQE. */
+  hello_uring_op_t* queue;
+  hello_uring_op_t** queue_tail;
+};
+
+static pthread_key_t g_ring_key;
+static pthread_once_t g_ring_once = PTHREAD_ONCE_INIT;
+static int g_available = -1;
+
+static int uring_enter(hello_uring_t* ring,
+                       unsigned to_submit,
+                       unsigned min_complete) {
+  unsigned flags = min_complete ? IORING_ENTER_GETEVENTS : 0;
+  long result;
+  do {
+    result = syscall(SYS_io_uring_enter, ring->fd, to_submit, min_complete,
+                     flags, NULL, 0);
+  } while (result < 0 && errno == EINTR);
+  return (int)result;
+}
+
+/* Whether a request ahead of `op` in the queue writes to the same fd. */
+static int uring_fd_busy(hello_uring_t* ring, hello_uring_op_t* op) {
+  hello_uring_op_t* prev;
+  for (prev = ring->queue; prev != op; prev = prev->next) {
+    if (prev->fd == op->fd)
+      return 1;
+  }
+  return 0;
+}
+
+/* Give an SQE to every queued request that is first in line for its fd, as
+ * long as there are SQ and CQ slots for it. Called with the ring locked. */
+static void uring_start_ready(hello_uring_t* ring) {
+  hello_uring_op_t* op;
+  for (op = ring->queue; op; op = op->next) {
+    if (ring->inflight >= ring->sq_entries ||
+        ring->inflight >= ring->cq_entries)
+      return;
+    if (op->started || uring_fd_busy(ring, op))
+      continue;
+    unsigned tail = *ring->sq_tail;
+    unsigned index = tail & ring->sq_mask;
+    struct io_uring_sqe* sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITEV;
+    sqe->fd = op->fd;
+    sqe->off = (uint64_t)-1;
+    sqe->addr = (uint64_t)(uintptr_t)op->iovs;
+    sqe->len = op->iovcnt;
+    sqe->user_data = (uint64_t)(uintptr_t)op;
+    ring->sq_array[index] = index;
+    op->started = 1;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ++ring->unsubmitted;
+    ++ring->inflight;
+  }
+}
+
+static void uring_dequeue(hello_uring_t* ring, hello_uring_op_t* op) {
+  hello_uring_op_t** link = &ring->queue;
+  while (*link != op)
+    link = &(*link)->next;
+  *link = op->next;
+  if (ring->queue_tail == &op->next)
+    ring->queue_tail = link;
+}
+
+/* Run the handlers of all completions that are ready, and start the requests
+ * that were waiting on them. Returns the number reaped. Called with the ring
+ * locked. */
+static unsigned uring_reap(hello_uring_t* ring) {
+  unsigned head = *ring->cq_head;
+  unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+  unsigned reaped = tail - head;
+  while (head != tail) {
+    struct io_uring_cqe* cqe = &ring->cqes[head & ring->cq_mask];
+    hello_uring_op_t* op = (hello_uring_op_t*)(uintptr_t)cqe->user_data;
+    int result = cqe->res;
+    ++head;
+    __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    --ring->inflight;
+    uring_dequeue(ring, op);
+    /* A short write is finished here, before the next write to the fd. */
+    op->complete(op, result);
+    __atomic_store_n(&op->pending, 0, __ATOMIC_RELEASE);
+  }
+  if (reaped)
+    uring_start_ready(ring);
+  return reaped;
+}
+
+/* Hand every queued request to the kernel. Called with the ring locked. */
+static void uring_submit(hello_uring_t* ring) {
+  while (ring->unsubmitted > 0) {
+    int submitted = uring_enter(ring, ring->unsubmitted, 0);
+    if (submitted >= 0) {
+      ring->unsubmitted -= (unsigned)submitted;
+      continue;
+    }
+    if (errno != EAGAIN && errno != EBUSY) {
+      perror("io_uring_enter");
+      abort();
+    }
+    /* The kernel has no room for more until completions are taken off the
+     * CQ: take those that are there, or wait for one. */
+    if (uring_reap(ring) == 0 && ring->inflight > ring->unsubmitted &&
+        uring_enter(ring, 0, 1) < 0 && errno != EAGAIN && errno != EBUSY) {
+      perror("io_uring_enter");
+      abort();
+    }
+  }
+}
+
+/* Wait for at least one completion and reap everything that is ready. */
+static void uring_reap_one(hello_uring_t* ring) {
+  uring_submit(ring);
+  /* Making room to submit may already have reaped everything. */
+  if (ring->inflight == 0)
+    return;
+  if (uring_enter(ring, 0, 1) < 0) {
+    perror("io_uring_enter");
+    abort();
+  }
+  uring_reap(ring);
+}
+
+static void destroy_ring(void* arg) {
+  hello_uring_t* ring = arg;
+  pthread_mutex_lock(&ring->mutex);
+  while (ring->queue)
+    uring_reap_one(ring);
+  pthread_mutex_unlock(&ring->mutex);
+  munmap(ring->sqes, ring->sq_entries * sizeof(struct io_uring_sqe));
+  if (ring->cq_ring != ring->sq_ring)
+    munmap(ring->cq_ring, ring->cq_ring_size);
+  munmap(ring->sq_ring, ring->sq_ring_size);
+  close(ring->fd);
+  pthread_mutex_destroy(&ring->mutex);
+  free(ring);
+}
+
+/* Key destructors do not run for the main thread, which ends in exit(). */
+static void destroy_current_ring(void) {
+  hello_uring_t* ring = pthread_getspecific(g_ring_key);
+  if (ring) {
+    pthread_setspecific(g_ring_key, NULL);
+    destroy_ring(ring);
+  }
+}
+
+static void create_ring_key(void) {
+  pthread_key_create(&g_ring_key, destroy_ring);
+  atexit(destroy_current_ring);
+}
+
+static hello_uring_t* create_ring(void) {
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int fd = (int)syscall(SYS_io_uring_setup, URING_ENTRIES, &params);
+  if (fd < 0)
+    return NULL;
+
+  hello_uring_t* ring = calloc(1, sizeof(*ring));
+  if (!ring) {
+    close(fd);
+    return NULL;
+  }
+  ring->fd = fd;
+  ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring->cq_ring_size =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  int single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap && ring->cq_ring_size > ring->sq_ring_size)
+    ring->sq_ring_size = ring->cq_ring_size;
+
+  ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  ring->cq_ring = single_mmap ? ring->sq_ring
+                              : mmap(NULL, ring->cq_ring_size,
+                                     PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE, fd,
+                                     IORING_OFF_CQ_RING);
+  ring->sqes = mmap(NULL, params.sq_entries * sizeof(struct io_uring_sqe),
+                    PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                    IORING_OFF_SQES);
+  if (ring->sq_ring == MAP_FAILED || ring->cq_ring == MAP_FAILED ||
+      ring->sqes == MAP_FAILED) {
+    perror("io_uring mmap");
+    abort();
+  }
+
+  uint8_t* sq = ring->sq_ring;
+  uint8_t* cq = ring->cq_ring;
+  ring->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+  ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+  ring->sq_mask = *(unsigned*)(sq + params.sq_off.ring_mask);
+  ring->sq_entries = params.sq_entries;
+  ring->cq_head = (unsigned*)(cq + params.cq_off.head);
+  ring->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+  ring->cq_mask = *(unsigned*)(cq + params.cq_off.ring_mask);
+  ring->cq_entries = params.cq_entries;
+  ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+  ring->queue_tail = &ring->queue;
+  pthread_mutex_init(&ring->mutex, NULL);
+  return ring;
+}
+
+int hello_uring_available(void) {
+  int available = __atomic_load_n(&g_available, __ATOMIC_RELAXED);
+  if (available < 0) {
+    /* io_uring can be compiled out or disabled by sysctl or seccomp. */
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = (int)syscall(SYS_io_uring_setup, 1, &params);
+    available = fd >= 0;
+    if (fd >= 0)
+      close(fd);
+    __atomic_store_n(&g_available, available, __ATOMIC_RELAXED);
+  }
+  return available;
+}
+
+hello_uring_t* hello_uring_current(void) {
+  if (!hello_uring_available())
+    return NULL;
+  pthread_once(&g_ring_once, create_ring_key);
+  hello_uring_t* ring = pthread_getspecific(g_ring_key);
+  if (!ring) {
+    ring = create_ring();
+    if (ring)
+      pthread_setspecific(g_ring_key, ring);
+  }
+  return ring;
+}
+
+int hello_uring_writev(hello_uring_t* ring,
+                       hello_uring_op_t* op,
+                       int fd,
+                       const struct iovec* iovs,
+                       unsigned iovcnt) {
+  pthread_mutex_lock(&ring->mutex);
+  op->fd = fd;
+  op->iovs = iovs;
+  op->iovcnt = iovcnt;
+  op->started = 0;
+  op->next = NULL;
+  op->pending = 1;
+  *ring->queue_tail = op;
+  ring->queue_tail = &op->next;
+
+  /* Reap whatever else has finished while we are here, then start `op`
+   * unless an earlier write to `fd` is still going. */
+  uring_reap(ring);
+  uring_start_ready(ring);
+  uring_submit(ring);
+  pthread_mutex_unlock(&ring->mutex);
+  return 0;
+}
+
+void hello_uring_wait(hello_uring_t* ring, hello_uring_op_t* op) {
+  if (!__atomic_load_n(&op->pending, __ATOMIC_ACQUIRE))
+    return;
+  pthread_mutex_lock(&ring->mutex);
+  uring_reap(ring);
+  while (__atomic_load_n(&op->pending, __ATOMIC_ACQUIRE))
+    uring_reap_one(ring);
+  pthread_mutex_unlock(&ring->mutex);
+}
+
+#else
+
+int hello_uring_available(void) {
+  return 0;
+}
+
+hello_uring_t* hello_uring_current(void) {
+  return NULL;
+}
+
+int hello_uring_writev(hello_uring_t* ring,
+                       hello_uring_op_t* op,
+                       int fd,
+                       const struct iovec* iovs,
+                       unsigned iovcnt) {
+  return -1;
+}
+
+void hello_uring_wait(hello_uring_t* ring, hello_uring_op_t* op) {}
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef HELLO_URING_H_
+#define HELLO_URING_H_
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sys/uio.h>
+
+/* Minimal io_uring client for the host's WASI imports, on the raw syscalls
+ * so that it needs neither liburing nor anything beyond a stock kernel.
+ * Each thread gets its own ring, shared by every instance running on that
+ * thread. Submitting costs one syscall that does not wait for the write;
+ * completions are reaped in batches from the shared completion queue, without
+ * a syscall unless someone has to wait. Writes to one fd through one ring
+ * reach the kernel one at a time, in the order they were submitted, so the
+ * output of instances sharing the ring never interleaves or reorders. A ring
+ * is drained when its thread exits, and the main thread's at exit(). */
+
+typedef struct hello_uring_t hello_uring_t;
+
+/* One request. Embed it in the state it belongs to; it must stay alive and
+ * the buffers it names untouched until `complete` has run. */
+typedef struct hello_uring_op_t hello_uring_op_t;
+struct hello_uring_op_t {
+  /* Called with the ring locked, on whichever thread reaps the completion.
+   * `result` is the syscall result: bytes written or -errno. */
+  void (*complete)(hello_uring_op_t* op, int result);
+  int pending;
+  /* Private to hello-uring.c. */
+  int fd;
+  const struct iovec* iovs;
+  unsigned iovcnt;
+  int started;
+  hello_uring_op_t* next;
+};
+
+/* Whether the kernel supports io_uring (checked once). */
+extern int hello_uring_available(void);
+
+/* The calling thread's ring, created on first use. NULL if io_uring is
+ * unavailable. */
+extern hello_uring_t* hello_uring_current(void);
+
+/* Submit a writev at the current file position, after every write to `fd`
+ * submitted on `ring` before it. Returns -1 if the request could not be
+ * submitted. */
+extern int hello_uring_writev(hello_uring_t* ring,
+                              hello_uring_op_t* op,
+                              int fd,
+                              const struct iovec* iovs,
+                              unsigned iovcnt);
+
+/* Block until `op`, queued on `ring`, has completed. Any thread may wait. */
+extern void hello_uring_wait(hello_uring_t* ring, hello_uring_op_t* op);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* HELLO_URING_H_ */
@@ -0,0 +1,790 @@
+/*
+ * Copyright 2018 WebAssembly Community Group participants
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__linux__)
+#define _GNU_SOURCE /* memfd_create, pthread_getattr_np */
+#endif
+
+#include "wasm-rt-impl.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER_POSIX
+#include <signal.h>
+#include <ucontext.h>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
+#define PAGE_SIZE 65536
+/* wasm32 allows 65536 pages, but the byte length of that many no longer fits
+ * the u32 `size` of a memory, so memories stop one page short of it. */
+#define MAX_PAGES 65535u
+/* Granularity at which all-zero parts of a snapshot are left as holes. */
+#define SNAPSHOT_CHUNK_SIZE 4096
+
+/* Linear memories are placed in reserved address space and grown in place
+ * wherever mmap is available; otherwise they live on the heap and growing
+ * them reallocates. */
+#if defined(__unix__) || defined(__APPLE__)
+#define WASM_RT_RESERVE_MEMORY 1
+#else
+#define WASM_RT_RESERVE_MEMORY 0
+#endif
+
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER_POSIX
+/* 4GiB of addressable memory plus 4GiB of guard region, so that any u32
+ * address plus u32 offset faults instead of touching a neighbouring mapping. */
+#define RESERVATION_SIZE 0x200000000ul
+#endif
+
+typedef struct FuncType {
+  wasm_rt_type_t* params;
+  wasm_rt_type_t* results;
+  uint32_t param_count;
+  uint32_t result_count;
+} FuncType;
+
+WASM_RT_THREAD_LOCAL uint32_t wasm_rt_call_stack_depth;
+WASM_RT_THREAD_LOCAL uint32_t g_saved_call_stack_depth;
+WASM_RT_THREAD_LOCAL bool g_try_armed;
+
+#if WASM_RT_STACK_LIMIT
+WASM_RT_THREAD_LOCAL uintptr_t wasm_rt_stack_limit = UINTPTR_MAX;
+#endif
+
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER_POSIX
+static pthread_once_t g_signal_handler_once = PTHREAD_ONCE_INIT;
+
+/* Base addresses of the live reservations, so that the signal handler can
+ * tell a guest's out-of-bounds access from any other fault. The handler may
+ * interrupt a thread anywhere, so slots are claimed and released with atomics
+ * instead of under a lock; 0 is a free slot, and every slot in use is below
+ * `g_reservation_end`. At 8GiB each, a 47-bit address space holds fewer than
+ * MAX_RESERVATIONS of them. */
+#define MAX_RESERVATIONS 16384
+static uintptr_t g_reservations[MAX_RESERVATIONS];
+static uint32_t g_reservation_end;
+#endif
+
+WASM_RT_THREAD_LOCAL sigjmp_buf g_jmp_buf;
+static pthread_mutex_t g_func_types_mutex = PTHREAD_MUTEX_INITIALIZER;
+static FuncType* g_func_types;
+static uint32_t g_func_type_count;
+
+WASM_RT_THREAD_LOCAL wasm_rt_trap_info_t wasm_rt_last_trap;
+static uint64_t g_trap_counts[WASM_RT_TRAP_INTERRUPT + 1];
+
+uint64_t wasm_rt_epoch;
+static WASM_RT_THREAD_LOCAL wasm_rt_epoch_handler_t g_epoch_handler;
+static WASM_RT_THREAD_LOCAL void* g_epoch_handler_data;
+
+__attribute__((noreturn)) static void trap_at(wasm_rt_trap_t code,
+                                              const void* pc,
+                                              const void* fault_addr) {
+  assert(code != WASM_RT_TRAP_NONE);
+  if (!g_try_armed) {
+    fprintf(stderr, "wasm-rt: trap %d with no wasm_rt_impl_try armed\n", code);
+    abort();
+  }
+  wasm_rt_last_trap.code = code;
+  wasm_rt_last_trap.pc = pc;
+  wasm_rt_last_trap.fault_addr = fault_addr;
+  __atomic_fetch_add(&g_trap_counts[code], 1, __ATOMIC_RELAXED);
+  wasm_rt_call_stack_depth = g_saved_call_stack_depth;
+  WASM_RT_LONGJMP(g_jmp_buf, code);
+}
+
+__attribute__((noinline)) void wasm_rt_trap(wasm_rt_trap_t code) {
+  trap_at(code, __builtin_return_address(0), NULL);
+}
+
+uint64_t wasm_rt_trap_count(wasm_rt_trap_t code) {
+  return __atomic_load_n(&g_trap_counts[code], __ATOMIC_RELAXED);
+}
+
+void wasm_rt_increment_epoch(void) {
+  __atomic_add_fetch(&wasm_rt_epoch, 1, __ATOMIC_RELAXED);
+}
+
+void wasm_rt_set_epoch_handler(wasm_rt_epoch_handler_t handler,
+                               void* user_data) {
+  g_epoch_handler = handler;
+  g_epoch_handler_data = user_data;
+}
+
+__attribute__((noinline)) void wasm_rt_epoch_deadline_reached(
+    uint64_t* deadline) {
+  uint64_t extension =
+      g_epoch_handler ? g_epoch_handler(g_epoch_handler_data) : 0;
+  if (extension == 0)
+    trap_at(WASM_RT_TRAP_INTERRUPT, __builtin_return_address(0), NULL);
+  uint64_t epoch = __atomic_load_n(&wasm_rt_epoch, __ATOMIC_RELAXED);
+  *deadline = extension > UINT64_MAX - epoch ? UINT64_MAX : epoch + extension;
+}
+
+#if WASM_RT_STACK_LIMIT
+/* Without a way to ask for the stack bounds, allow this much below the frame
+ * that first enters the guest on a thread. */
+#define FALLBACK_STACK_SIZE (256 * 1024)
+
+static uintptr_t thread_stack_limit(void) {
+#if defined(__linux__)
+  pthread_attr_t attr;
+  void* addr;
+  size_t size;
+  if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+    int result = pthread_attr_getstack(&attr, &addr, &size);
+    pthread_attr_destroy(&attr);
+    if (result == 0)
+      return (uintptr_t)addr + WASM_RT_STACK_RESERVE;
+  }
+#endif
+  return (uintptr_t)__builtin_frame_address(0) - FALLBACK_STACK_SIZE;
+}
+
+__attribute__((noinline, cold)) void wasm_rt_check_stack(void) {
+  if (wasm_rt_stack_limit == UINTPTR_MAX) {
+    wasm_rt_stack_limit = thread_stack_limit();
+    if ((uintptr_t)__builtin_frame_address(0) >= wasm_rt_stack_limit)
+      return;
+  }
+  trap_at(WASM_RT_TRAP_EXHAUSTION, __builtin_return_address(0), NULL);
+}
+#endif
+
+static bool func_types_are_equal(FuncType* a, FuncType* b) {
+  if (a->param_count != b->param_count || a->result_count != b->result_count)
+    return 0;
+  uint32_t i;
+  for (i = 0; i < a->param_count; ++i)
+    if (a->params[i] != b->params[i])
+      return 0;
+  for (i = 0; i < a->result_count; ++i)
+    if (a->results[i] != b->results[i])
+      return 0;
+  return 1;
+}
+
+uint32_t wasm_rt_register_func_type(uint32_t param_count,
+                                    uint32_t result_count,
+                                    ...) {
+  FuncType func_type;
+  func_type.param_count = param_count;
+  func_type.params = malloc(param_count * sizeof(wasm_rt_type_t));
+  func_type.result_count = result_count;
+  func_type.results = malloc(result_count * sizeof(wasm_rt_type_t));
+
+  va_list args;
+  va_start(args, result_count);
+
+  uint32_t i;
+  for (i = 0; i < param_count; ++i)
+    func_type.params[i] = va_arg(args, wasm_rt_type_t);
+  for (i = 0; i < result_count; ++i)
+    func_type.results[i] = va_arg(args, wasm_rt_type_t);
+  va_end(args);
+
+  /* Anything that does not fit the canonical encoding, including counts that
+   * would spill into the tag bit, goes to the registry. */
+  bool canonical = result_count <= WASM_RT_CANONICAL_FUNC_TYPE_MAX_RESULTS &&
+                   param_count + result_count <= WASM_RT_CANONICAL_FUNC_TYPE_MAX;
+  for (i = 0; canonical && i < param_count; ++i)
+    canonical = (uint32_t)func_type.params[i] <= 3;
+  for (i = 0; canonical && i < result_count; ++i)
+    canonical = (uint32_t)func_type.results[i] <= 3;
+  if (canonical) {
+    uint32_t id = WASM_RT_CANONICAL_FUNC_TYPE_BIT | (result_count << 28) |
+                  (param_count << 24);
+    for (i = 0; i < param_count; ++i)
+      id |= (uint32_t)func_type.params[i] << (2 * i);
+    for (i = 0; i < result_count; ++i)
+      id |= (uint32_t)func_type.results[i] << (2 * (param_count + i));
+    free(func_type.params);
+    free(func_type.results);
+    return id;
+  }
+
+  pthread_mutex_lock(&g_func_types_mutex);
+  for (i = 0; i < g_func_type_count; ++i) {
+    if (func_types_are_equal(&g_func_types[i], &func_type)) {
+      pthread_mutex_unlock(&g_func_types_mutex);
+      free(func_type.params);
+      free(func_type.results);
+      return i + 1;
+    }
+  }
+
+  uint32_t idx = g_func_type_count++;
+  g_func_types = realloc(g_func_types, g_func_type_count * sizeof(FuncType));
+  g_func_types[idx] = func_type;
+  pthread_mutex_unlock(&g_func_types_mutex);
+  return idx + 1;
+}
+
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER_POSIX
+static const void* fault_pc(void* context) {
+  ucontext_t* uc = context;
+#if defined(__linux__) && defined(__x86_64__)
+  return (const void*)uc->uc_mcontext.gregs[REG_RIP];
+#elif defined(__linux__) && defined(__aarch64__)
+  return (const void*)uc->uc_mcontext.pc;
+#else
+  return NULL;
+#endif
+}
+
+static void register_reservation(uint8_t* addr) {
+  uint32_t i;
+  for (i = 0; i < MAX_RESERVATIONS; ++i) {
+    uintptr_t expected = 0;
+    if (__atomic_compare_exchange_n(&g_reservations[i], &expected,
+                                    (uintptr_t)addr, false, __ATOMIC_RELEASE,
+                                    __ATOMIC_RELAXED)) {
+      uint32_t end = __atomic_load_n(&g_reservation_end, __ATOMIC_RELAXED);
+      while (end <= i &&
+             !__atomic_compare_exchange_n(&g_reservation_end, &end, i + 1,
+                                          true, __ATOMIC_RELEASE,
+                                          __ATOMIC_RELAXED)) {
+      }
+      return;
+    }
+  }
+  fprintf(stderr, "wasm-rt: more than %d memory reservations\n",
+          MAX_RESERVATIONS);
+  abort();
+}
+
+static void unregister_reservation(uint8_t* addr) {
+  uint32_t end = __atomic_load_n(&g_reservation_end, __ATOMIC_ACQUIRE);
+  uint32_t i;
+  for (i = 0; i < end; ++i) {
+    if (__atomic_load_n(&g_reservations[i], __ATOMIC_RELAXED) ==
+        (uintptr_t)addr) {
+      __atomic_store_n(&g_reservations[i], 0, __ATOMIC_RELEASE);
+      return;
+    }
+  }
+}
+
+static bool in_reservation(const void* addr) {
+  uint32_t end = __atomic_load_n(&g_reservation_end, __ATOMIC_ACQUIRE);
+  uint32_t i;
+  for (i = 0; i < end; ++i) {
+    uintptr_t base = __atomic_load_n(&g_reservations[i], __ATOMIC_ACQUIRE);
+    if (base != 0 && (uintptr_t)addr - base < RESERVATION_SIZE)
+      return true;
+  }
+  return false;
+}
+
+static void signal_handler(int sig, siginfo_t* si, void* context) {
+  /* Anything but guest code running into a guard region with a trap handler
+   * to jump to is a real crash: restore the default action and return, so
+   * that the faulting instruction runs again and takes it. */
+  if (!g_try_armed || !in_reservation(si->si_addr)) {
+    signal(sig, SIG_DFL);
+    return;
+  }
+  trap_at(WASM_RT_TRAP_OOB, fault_pc(context), si->si_addr);
+}
+
+static void install_signal_handler_once(void) {
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  /* SA_NODEFER: the handler never returns, and leaving SIGSEGV blocked after
+   * the longjmp would turn the next fault into a crash. */
+  sa.sa_flags = SA_SIGINFO | SA_NODEFER;
+  sigemptyset(&sa.sa_mask);
+  sa.sa_sigaction = signal_handler;
+
+  /* Install SIGSEGV and SIGBUS handlers, since macOS seems to use SIGBUS. */
+  if (sigaction(SIGSEGV, &sa, NULL) != 0 ||
+      sigaction(SIGBUS, &sa, NULL) != 0) {
+    perror("sigaction failed");
+    abort();
+  }
+}
+
+static void install_signal_handler(void) {
+  pthread_once(&g_signal_handler_once, install_signal_handler_once);
+}
+#endif
+
+static wasm_rt_huge_pages_t g_huge_pages = WASM_RT_HUGE_PAGES_NONE;
+
+void wasm_rt_set_huge_pages(wasm_rt_huge_pages_t mode) {
+  g_huge_pages = mode;
+}
+
+/* The most pages a memory declared with `max_pages` can actually grow to. */
+static uint32_t effective_max_pages(uint32_t max_pages) {
+  return max_pages < MAX_PAGES ? max_pages : MAX_PAGES;
+}
+
+#if WASM_RT_RESERVE_MEMORY
+/* Whether a memory that starts at `size` bytes should use huge pages. */
+static bool use_huge_pages(size_t size) {
+#if defined(__linux__)
+  return g_huge_pages != WASM_RT_HUGE_PAGES_NONE &&
+         size >= WASM_RT_HUGE_PAGE_SIZE;
+#else
+  return false;
+#endif
+}
+
+/* Largest byte size a memory with `max_pages` can reach, whatever its
+ * declared maximum (UINT32_MAX for none). */
+static size_t max_memory_size(uint32_t max_pages) {
+  return (size_t)effective_max_pages(max_pages) * PAGE_SIZE;
+}
+
+/* Size of the address space reserved for a memory of at most `max_pages`.
+ * With the signal handler it also has to cover the guard region. */
+static size_t reservation_size(uint32_t max_pages) {
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER_POSIX
+  return RESERVATION_SIZE;
+#else
+  return (max_pages != 0 ? max_memory_size(max_pages) : PAGE_SIZE) +
+         WASM_RT_MEMORY_PADDING;
+#endif
+}
+
+/* Reserve the whole region up front; pages are committed on demand, so the
+ * base address never changes and growing never copies. With `huge` the
+ * region starts on a huge page boundary and is marked for THP. */
+static uint8_t* reserve_memory(uint32_t max_pages, bool huge) {
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER_POSIX
+  install_signal_handler();
+#endif
+  size_t size = reservation_size(max_pages);
+  size_t slack = huge ? WASM_RT_HUGE_PAGE_SIZE : 0;
+  uint8_t* addr = mmap(NULL, size + slack, PROT_NONE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (addr == MAP_FAILED) {
+    perror("mmap failed");
+    abort();
+  }
+#if defined(__linux__)
+  if (huge) {
+    uintptr_t mask = WASM_RT_HUGE_PAGE_SIZE - 1;
+    uint8_t* aligned = (uint8_t*)(((uintptr_t)addr + mask) & ~mask);
+    if (aligned != addr)
+      munmap(addr, aligned - addr);
+    munmap(aligned + size, addr + slack - aligned);
+    addr = aligned;
+    /* Best effort: THP may be disabled system-wide. */
+    madvise(addr, size, MADV_HUGEPAGE);
+  }
+#endif
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER_POSIX
+  register_reservation(addr);
+#endif
+  return addr;
+}
+
+static bool commit_memory(uint8_t* addr, size_t size) {
+  return size == 0 || mprotect(addr, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+/* Replace [addr, addr + size) with fresh reserved, inaccessible memory. */
+static void remap_reservation(uint8_t* addr, size_t size) {
+  if (mmap(addr, size, PROT_NONE,
+           MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_FIXED, -1,
+           0) == MAP_FAILED) {
+    perror("mmap failed");
+    abort();
+  }
+#if defined(__linux__)
+  /* The new mapping does not inherit MADV_HUGEPAGE. */
+  if (g_huge_pages != WASM_RT_HUGE_PAGES_NONE)
+    madvise(addr, size, MADV_HUGEPAGE);
+#endif
+}
+
+/* Make the WASM_RT_MEMORY_PADDING bytes after the largest size of a fresh
+ * reservation accessible. Nothing ever decommits them. */
+static void commit_padding(uint8_t* addr, uint32_t max_pages) {
+  if (WASM_RT_MEMORY_PADDING != 0 &&
+      !commit_memory(addr + max_memory_size(max_pages),
+                     WASM_RT_MEMORY_PADDING)) {
+    perror("mprotect failed");
+    abort();
+  }
+}
+
+/* Return anonymous [addr, addr + size) to the reserved, inaccessible state.
+ * Pages read as zero again once committed anew. The mapping itself is kept,
+ * and with it any huge page advice or NUMA policy set on it. */
+static void decommit_memory(uint8_t* addr, size_t size) {
+  if (size == 0)
+    return;
+  if (mprotect(addr, size, PROT_NONE) != 0 ||
+      madvise(addr, size, MADV_DONTNEED) != 0) {
+    perror("decommit failed");
+    abort();
+  }
+}
+
+/* Back the first `size` bytes of a fresh reservation with hugetlb pages.
+ * Returns the number of bytes mapped, 0 if the pool cannot provide them. */
+static size_t commit_explicit_huge_pages(uint8_t* addr, size_t size) {
+#if defined(__linux__) && defined(MAP_HUGETLB)
+  size &= ~(size_t)(WASM_RT_HUGE_PAGE_SIZE - 1);
+  if (g_huge_pages != WASM_RT_HUGE_PAGES_EXPLICIT || size == 0)
+    return 0;
+  if (mmap(addr, size, PROT_READ | PROT_WRITE,
+           MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB, -1,
+           0) == MAP_FAILED) {
+    /* A failed MAP_FIXED may already have unmapped the range; put the
+     * reservation back. */
+    remap_reservation(addr, size);
+    return 0;
+  }
+  return size;
+#else
+  return 0;
+#endif
+}
+#endif
+
+void wasm_rt_allocate_memory(wasm_rt_memory_t* memory,
+                             uint32_t initial_pages,
+                             uint32_t max_pages) {
+  uint32_t byte_length = initial_pages * PAGE_SIZE;
+#if WASM_RT_RESERVE_MEMORY
+  bool huge = use_huge_pages(byte_length);
+  uint8_t* addr = reserve_memory(max_pages, huge);
+  size_t committed = huge ? commit_explicit_huge_pages(addr, byte_length) : 0;
+  if (!commit_memory(addr + committed, byte_length - committed)) {
+    perror("mprotect failed");
+    abort();
+  }
+  commit_padding(addr, max_pages);
+  memory->data = addr;
+  memory->hugetlb_size = (uint32_t)committed;
+#else
+  memory->data = calloc(byte_length + WASM_RT_MEMORY_PADDING, 1);
+  memory->hugetlb_size = 0;
+#endif
+  memory->size = byte_length;
+  memory->pages = initial_pages;
+  memory->max_pages = max_pages;
+}
+
+void wasm_rt_free_memory(wasm_rt_memory_t* memory) {
+#if WASM_RT_RESERVE_MEMORY
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER_POSIX
+  unregister_reservation(memory->data);
+#endif
+  munmap(memory->data, reservation_size(memory->max_pages));
+#else
+  free(memory->data);
+#endif
+  memory->data = NULL;
+  memory->size = memory->pages = memory->hugetlb_size = 0;
+}
+
+static bool chunk_is_zero(const uint8_t* data, size_t size) {
+  size_t i;
+  for (i = 0; i < size; ++i)
+    if (data[i])
+      return false;
+  return true;
+}
+
+#if defined(__linux__)
+/* Write the non-zero chunks of `data` into a fresh memfd; the rest of the file
+ * stays a hole and costs no memory. Returns -1 on failure. */
+static int create_image_fd(const uint8_t* data, uint32_t size) {
+  int fd = memfd_create("wasm-rt-snapshot", MFD_CLOEXEC);
+  if (fd < 0)
+    return -1;
+  if (ftruncate(fd, size) != 0) {
+    close(fd);
+    return -1;
+  }
+  uint32_t offset;
+  for (offset = 0; offset < size; offset += SNAPSHOT_CHUNK_SIZE) {
+    uint32_t len = size - offset < SNAPSHOT_CHUNK_SIZE ? size - offset
+                                                       : SNAPSHOT_CHUNK_SIZE;
+    if (chunk_is_zero(data + offset, len))
+      continue;
+    if (pwrite(fd, data + offset, len, offset) != (ssize_t)len) {
+      close(fd);
+      return -1;
+    }
+  }
+  return fd;
+}
+#endif
+
+static void snapshot_bytes(wasm_rt_memory_snapshot_t* snapshot,
+                           const uint8_t* bytes,
+                           uint32_t pages) {
+  uint32_t size = pages * PAGE_SIZE;
+  snapshot->fd = -1;
+  snapshot->pages = pages;
+  snapshot->size = size;
+#if defined(__linux__)
+  if (size != 0) {
+    int fd = create_image_fd(bytes, size);
+    if (fd >= 0) {
+      void* data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+      if (data != MAP_FAILED) {
+        snapshot->fd = fd;
+        snapshot->data = data;
+        return;
+      }
+      close(fd);
+    }
+  }
+#endif
+  uint8_t* copy = malloc(size);
+  if (copy == NULL && size != 0) {
+    perror("malloc failed");
+    abort();
+  }
+  memcpy(copy, bytes, size);
+  snapshot->data = copy;
+}
+
+void wasm_rt_snapshot_memory(wasm_rt_memory_snapshot_t* snapshot,
+                             const wasm_rt_memory_t* memory) {
+  snapshot_bytes(snapshot, memory->data, memory->pages);
+}
+
+void wasm_rt_create_memory_image(wasm_rt_memory_snapshot_t* image,
+                                 const wasm_rt_data_segment_t* segments,
+                                 uint32_t segment_count) {
+  uint64_t end = 0;
+  uint32_t i;
+  for (i = 0; i < segment_count; ++i)
+    if ((uint64_t)segments[i].offset + segments[i].size > end)
+      end = (uint64_t)segments[i].offset + segments[i].size;
+  uint32_t pages = (uint32_t)((end + PAGE_SIZE - 1) / PAGE_SIZE);
+  uint8_t* bytes = calloc(pages, PAGE_SIZE);
+  if (bytes == NULL && pages != 0) {
+    perror("calloc failed");
+    abort();
+  }
+  for (i = 0; i < segment_count; ++i)
+    memcpy(bytes + segments[i].offset, segments[i].data, segments[i].size);
+  snapshot_bytes(image, bytes, pages);
+  free(bytes);
+}
+
+void wasm_rt_map_memory_image(wasm_rt_memory_t* memory,
+                              const wasm_rt_memory_snapshot_t* image) {
+  if (image->size > memory->size)
+    wasm_rt_trap(WASM_RT_TRAP_OOB);
+#if WASM_RT_RESERVE_MEMORY
+  /* hugetlb pages cannot be partly replaced by a file mapping. Memories
+   * whose hugetlb mapping failed are ordinary pages and still can. */
+  if (image->fd >= 0 && image->size != 0 && memory->hugetlb_size == 0) {
+    if (mmap(memory->data, image->size, PROT_READ | PROT_WRITE,
+             MAP_PRIVATE | MAP_FIXED, image->fd, 0) != MAP_FAILED)
+      return;
+    /* A failed MAP_FIXED may already have unmapped the range. */
+    remap_reservation(memory->data, image->size);
+    if (!commit_memory(memory->data, image->size)) {
+      perror("mprotect failed");
+      abort();
+    }
+  }
+#endif
+  memcpy(memory->data, image->data, image->size);
+}
+
+void wasm_rt_free_memory_snapshot(wasm_rt_memory_snapshot_t* snapshot) {
+#if defined(__linux__)
+  if (snapshot->fd >= 0) {
+    munmap((void*)snapshot->data, snapshot->size);
+    close(snapshot->fd);
+  } else
+#endif
+  {
+    free((void*)snapshot->data);
+  }
+  snapshot->fd = -1;
+  snapshot->data = NULL;
+}
+
+void wasm_rt_allocate_memory_from_snapshot(
+    wasm_rt_memory_t* memory,
+    const wasm_rt_memory_snapshot_t* snapshot,
+    uint32_t max_pages) {
+  uint32_t size = snapshot->size;
+#if WASM_RT_RESERVE_MEMORY
+  /* Private copies of image pages are anonymous memory, which THP can
+   * collapse; hugetlb cannot back a file mapping. */
+  uint8_t* addr = reserve_memory(max_pages, use_huge_pages(size));
+  if (size != 0) {
+    if (snapshot->fd >= 0) {
+      if (mmap(addr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+               snapshot->fd, 0) == MAP_FAILED) {
+        perror("mmap failed");
+        abort();
+      }
+    } else {
+      if (!commit_memory(addr, size)) {
+        perror("mprotect failed");
+        abort();
+      }
+      memcpy(addr, snapshot->data, size);
+    }
+  }
+  commit_padding(addr, max_pages);
+  memory->data = addr;
+#else
+  memory->data = malloc(size + WASM_RT_MEMORY_PADDING);
+  memcpy(memory->data, snapshot->data, size);
+#endif
+  memory->size = size;
+  memory->pages = snapshot->pages;
+  memory->max_pages = max_pages;
+  memory->hugetlb_size = 0;
+}
+
+void wasm_rt_reset_memory(wasm_rt_memory_t* memory,
+                          const wasm_rt_memory_snapshot_t* snapshot) {
+  uint32_t size = snapshot->size;
+#if WASM_RT_RESERVE_MEMORY
+  /* Decommit whatever the memory grew by since it was created. */
+  if (memory->size > size)
+    decommit_memory(memory->data + size, memory->size - size);
+  if (snapshot->fd >= 0) {
+    /* Drop the private copies of dirtied pages; the next access maps the
+     * image page again. Clean pages cost nothing here. */
+    if (size != 0 && madvise(memory->data, size, MADV_DONTNEED) != 0) {
+      perror("madvise failed");
+      abort();
+    }
+  } else {
+    memcpy(memory->data, snapshot->data, size);
+  }
+#else
+  if (memory->size != size) {
+    uint8_t* new_data = realloc(memory->data, size + WASM_RT_MEMORY_PADDING);
+    if (new_data != NULL || size == 0)
+      memory->data = new_data;
+  }
+  memcpy(memory->data, snapshot->data, size);
+#endif
+  memory->size = size;
+  memory->pages = snapshot->pages;
+}
+
+uint32_t wasm_rt_discard_memory(wasm_rt_memory_t* memory,
+                                uint32_t offset,
+                                uint32_t size) {
+#if WASM_RT_RESERVE_MEMORY
+  if (offset >= memory->size)
+    return 0;
+  if (size > memory->size - offset)
+    size = memory->size - offset;
+  uintptr_t page_mask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1;
+  uintptr_t start = ((uintptr_t)memory->data + offset + page_mask) & ~page_mask;
+  uintptr_t end = ((uintptr_t)memory->data + offset + size) & ~page_mask;
+  /* Fails with EINVAL on hugetlb pages, which cannot be split. */
+  if (end <= start || madvise((void*)start, end - start, MADV_DONTNEED) != 0)
+    return 0;
+  return (uint32_t)(end - start);
+#else
+  return 0;
+#endif
+}
+
+int wasm_rt_bind_memory_to_node(wasm_rt_memory_t* memory, int node) {
+#if WASM_RT_RESERVE_MEMORY && defined(__linux__) && defined(SYS_mbind)
+  unsigned long nodemask[4] = {0};
+  const unsigned long bits = sizeof(nodemask[0]) * 8;
+  if (node < 0 || (unsigned long)node >= sizeof(nodemask) * 8)
+    return -1;
+  nodemask[node / bits] = 1ul << (node % bits);
+  /* The whole reservation, so pages committed by later growth follow the
+   * policy too. Pages already shared with the snapshot stay where they are. */
+  if (syscall(SYS_mbind, memory->data, reservation_size(memory->max_pages),
+              MPOL_PREFERRED, nodemask, sizeof(nodemask) * 8, 0) != 0)
+    return -1;
+  return 0;
+#else
+  (void)memory;
+  (void)node;
+  return -1;
+#endif
+}
+
+uint32_t wasm_rt_grow_memory(wasm_rt_memory_t* memory, uint32_t delta) {
+  uint32_t old_pages = memory->pages;
+  uint32_t new_pages = memory->pages + delta;
+  if (new_pages < old_pages ||
+      new_pages > effective_max_pages(memory->max_pages)) {
+    return (uint32_t)-1;
+  }
+  if (delta == 0) {
+    return old_pages;
+  }
+  uint32_t old_size = old_pages * PAGE_SIZE;
+  uint32_t new_size = new_pages * PAGE_SIZE;
+  uint32_t delta_size = delta * PAGE_SIZE;
+#if WASM_RT_RESERVE_MEMORY
+  /* O(delta): the pages are already reserved at their final address. */
+  uint8_t* new_data = memory->data;
+  if (!commit_memory(new_data + old_size, delta_size)) {
+    return (uint32_t)-1;
+  }
+#else
+  uint8_t* new_data = realloc(memory->data, new_size + WASM_RT_MEMORY_PADDING);
+  if (new_data == NULL) {
+    return (uint32_t)-1;
+  }
+  memset(new_data + old_size, 0, delta_size);
+#endif
+  memory->pages = new_pages;
+  memory->size = new_size;
+  memory->data = new_data;
+  return old_pages;
+}
+
+void wasm_rt_allocate_table(wasm_rt_table_t* table,
+                            uint32_t elements,
+                            uint32_t max_elements) {
+  table->size = elements;
+  table->max_size = max_elements;
+  table->data = calloc(table->size, sizeof(wasm_rt_elem_t));
+}
+
+void wasm_rt_free_table(wasm_rt_table_t* table) {
+  free(table->data);
+  table->data = NULL;
+  table->size = 0;
+}
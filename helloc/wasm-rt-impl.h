@@ -0,0 +1,96 @@
+/*
+ * Copyright 2018 WebAssembly Community Group participants
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WASM_RT_IMPL_H_
+#define WASM_RT_IMPL_H_
+
+#include <setjmp.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "wasm-rt.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** A setjmp buffer used for handling traps, one per thread. */
+extern WASM_RT_THREAD_LOCAL sigjmp_buf g_jmp_buf;
+
+/* Arming a trap handler must stay cheap enough to do once per export call, so
+ * the signal mask is never saved (that would be a syscall). The SIGSEGV
+ * handler is installed with SA_NODEFER, so jumping out of it leaves nothing
+ * blocked that would need restoring. */
+#define WASM_RT_SETJMP(buf) sigsetjmp(buf, 0)
+#define WASM_RT_LONGJMP(buf, val) siglongjmp(buf, val)
+
+/** Saved call stack depth that will be restored in case a trap occurs. */
+extern WASM_RT_THREAD_LOCAL uint32_t g_saved_call_stack_depth;
+
+/** Whether `g_jmp_buf` belongs to a live `wasm_rt_impl_try`. A trap while it
+ * is clear aborts, and the SIGSEGV handler leaves the fault alone. */
+extern WASM_RT_THREAD_LOCAL bool g_try_armed;
+
+/** The trap handler a thread had armed, if any, saved by
+ * `wasm_rt_impl_try_begin` and put back by `wasm_rt_impl_try_end`. */
+typedef struct {
+  sigjmp_buf jmp_buf;
+  uint32_t saved_call_stack_depth;
+  bool armed;
+} wasm_rt_impl_try_scope_t;
+
+/** Convenience macro to use before calling a wasm function. On first execution
+ * it will return `WASM_RT_TRAP_NONE` (i.e. 0). If the function traps, it will
+ * jump back and return the trap that occurred. Bracket it and the calls it
+ * guards with `wasm_rt_impl_try_begin` and `wasm_rt_impl_try_end`, so that
+ * the trap handler is disarmed (or the caller's restored) once the frame that
+ * armed it can no longer be jumped to.
+ *
+ *  ```
+ *    wasm_rt_impl_try_scope_t scope;
+ *    wasm_rt_impl_try_begin(&scope);
+ *    wasm_rt_trap_t code = wasm_rt_impl_try();
+ *    if (code != 0) {
+ *      printf("A trap occurred with code: %d\n", code);
+ *      ...
+ *    } else {
+ *      // Call the potentially-trapping function.
+ *      my_wasm_func();
+ *    }
+ *    wasm_rt_impl_try_end(&scope);
+ *  ```
+ */
+#define wasm_rt_impl_try()                                 \
+  (g_saved_call_stack_depth = wasm_rt_call_stack_depth, \
+   g_try_armed = true, WASM_RT_SETJMP(g_jmp_buf))
+
+static inline void wasm_rt_impl_try_begin(wasm_rt_impl_try_scope_t* scope) {
+  memcpy(scope->jmp_buf, g_jmp_buf, sizeof(scope->jmp_buf));
+  scope->saved_call_stack_depth = g_saved_call_stack_depth;
+  scope->armed = g_try_armed;
+}
+
+static inline void wasm_rt_impl_try_end(const wasm_rt_impl_try_scope_t* scope) {
+  memcpy(g_jmp_buf, scope->jmp_buf, sizeof(g_jmp_buf));
+  g_saved_call_stack_depth = scope->saved_call_stack_depth;
+  g_try_armed = scope->armed;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WASM_RT_IMPL_H_ */
@@ -0,0 +1,137 @@
+/* Checks of wasm-rt-impl.c that the benchmark does not exercise.
+ *
+ *   wasm-rt-test
+ *
+ * Built with WASM_RT_MEMCHECK_SIGNAL_HANDLER=1 it also checks which faults
+ * the signal handler turns into traps.
+ *
+ * Prints each failed check and exits with 1 if there was any. */
+
+#include <signal.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "wasm-rt-impl.h"
+
+static int g_failures;
+
+#define CHECK(cond)                                                  \
+  do {                                                               \
+    if (!(cond)) {                                                   \
+      fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, \
+              #cond);                                                \
+      ++g_failures;                                                  \
+    }                                                                \
+  } while (0)
+
+/* Result counts that do not fit bits 28-30 must not alias a canonical ID. */
+static void test_func_type_ids(void) {
+  uint32_t empty = wasm_rt_register_func_type(0, 0);
+  uint32_t eight_results = wasm_rt_register_func_type(
+      0, 8, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32, WASM_RT_I32,
+      WASM_RT_I32, WASM_RT_I32, WASM_RT_I32);
+  CHECK(empty == WASM_RT_CANONICAL_FUNC_TYPE_BIT);
+  CHECK(eight_results != empty);
+  CHECK((eight_results & WASM_RT_CANONICAL_FUNC_TYPE_BIT) == 0);
+  CHECK(eight_results ==
+        wasm_rt_register_func_type(0, 8, WASM_RT_I32, WASM_RT_I32,
+                                   WASM_RT_I32, WASM_RT_I32, WASM_RT_I32,
+                                   WASM_RT_I32, WASM_RT_I32, WASM_RT_I32));
+  /* The examples in wasm-rt.h. */
+  CHECK(wasm_rt_register_func_type(2, 1, WASM_RT_I32, WASM_RT_F32,
+                                   WASM_RT_I64) == 0x92000018u);
+  CHECK(wasm_rt_register_func_type(0, 1, WASM_RT_I64) == 0x90000001u);
+}
+
+/* A memory without a maximum reserves at most the 4GiB wasm32 limit and
+ * cannot grow to 65536 pages, whose byte length would wrap `size`. */
+static void test_unbounded_memory(void) {
+  wasm_rt_memory_t memory;
+  wasm_rt_allocate_memory(&memory, 1, UINT32_MAX);
+  CHECK(wasm_rt_grow_memory(&memory, 3) == 1);
+  CHECK(memory.pages == 4);
+  CHECK(wasm_rt_grow_memory(&memory, 65536 - 4) == UINT32_MAX);
+  CHECK(wasm_rt_grow_memory(&memory, 65546 - 4) == UINT32_MAX);
+  CHECK(memory.pages == 4);
+  CHECK(memory.size == 4 * 65536);
+  wasm_rt_free_memory(&memory);
+}
+
+/* A trap once the frame that armed the trap handler has ended must abort
+ * instead of jumping into that frame. */
+static void test_trap_after_try(void) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    wasm_rt_impl_try_scope_t scope;
+    wasm_rt_impl_try_begin(&scope);
+    if (wasm_rt_impl_try() != 0)
+      _exit(0);
+    wasm_rt_impl_try_end(&scope);
+    wasm_rt_trap(WASM_RT_TRAP_OOB);
+  }
+  int status;
+  CHECK(waitpid(pid, &status, 0) == pid && WIFSIGNALED(status) &&
+        WTERMSIG(status) == SIGABRT);
+}
+
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER_POSIX
+static bool g_in_child;
+
+/* Whether reading `addr` in a child process kills it with SIGSEGV, with or
+ * without a trap handler armed. */
+static bool read_crashes(const volatile uint8_t* addr, bool arm) {
+  pid_t pid = fork();
+  if (pid == 0) {
+    g_in_child = true;
+    wasm_rt_impl_try_scope_t scope;
+    wasm_rt_impl_try_begin(&scope);
+    if (!arm || wasm_rt_impl_try() == 0)
+      (void)*addr;
+    wasm_rt_impl_try_end(&scope);
+    _exit(0);
+  }
+  int status;
+  return waitpid(pid, &status, 0) == pid && WIFSIGNALED(status) &&
+         WTERMSIG(status) == SIGSEGV;
+}
+
+/* Only a fault in a live reservation with a trap handler armed is a trap. */
+static void test_signal_handler(void) {
+  wasm_rt_memory_t memory;
+  wasm_rt_allocate_memory(&memory, 1, 1);
+  const volatile uint8_t* guard = memory.data + memory.size;
+  wasm_rt_impl_try_scope_t scope;
+  wasm_rt_impl_try_begin(&scope);
+  wasm_rt_trap_t trap = wasm_rt_impl_try();
+  if (g_in_child) /* a child's fault jumped to this stale trap handler */
+    _exit(0);
+  if (trap == WASM_RT_TRAP_NONE)
+    (void)*guard;
+  wasm_rt_impl_try_end(&scope);
+  CHECK(trap == WASM_RT_TRAP_OOB);
+  CHECK(read_crashes(guard, false));
+
+  uint8_t* other = mmap(NULL, 4096, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS,
+                        -1, 0);
+  CHECK(read_crashes(other, true));
+  munmap(other, 4096);
+
+  wasm_rt_free_memory(&memory);
+}
+#endif
+
+int main(void) {
+  test_func_type_ids();
+  test_unbounded_memory();
+  test_trap_after_try();
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER_POSIX
+  test_signal_handler();
+#endif
+  if (g_failures) {
+    fprintf(stderr, "wasm-rt-test: %d check(s) failed\n", g_failures);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,414 @@
+/*
+ * Copyright 2018 WebAssembly Community Group participants
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef WASM_RT_H_
+#define WASM_RT_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum stack depth before trapping. This can be configured by defining
+ * this symbol before including wasm-rt when building the generated c files,
+ * for example:
+ *
+ * ```
+ *   cc -c -DWASM_RT_MAX_CALL_STACK_DEPTH=100 my_module.c -o my_module.o
+ * ```
+ * */
+#ifndef WASM_RT_MAX_CALL_STACK_DEPTH
+#define WASM_RT_MAX_CALL_STACK_DEPTH 500
+#endif
+
+/** Enable memory checking via a signal handler via the following definition:
+ *
+ * #define WASM_RT_MEMCHECK_SIGNAL_HANDLER 1
+ *
+ * Every linear memory then reserves 8GiB of address space, of which only the
+ * live pages are accessible. Any 32-bit address plus offset lands inside the
+ * reservation, so an out-of-bounds access faults on an inaccessible page and
+ * the SIGSEGV handler turns it into `WASM_RT_TRAP_OOB`. The generated code
+ * drops its explicit `MEMCHECK`s in this mode.
+ *
+ * The same value must be used for the generated code and for wasm-rt-impl.c.
+ * */
+#ifndef WASM_RT_MEMCHECK_SIGNAL_HANDLER
+#define WASM_RT_MEMCHECK_SIGNAL_HANDLER 0
+#endif
+
+/** Check whether the signal handler is supported at all. */
+#if WASM_RT_MEMCHECK_SIGNAL_HANDLER
+#if (defined(__linux__) || defined(__unix__) || defined(__APPLE__)) && \
+    UINTPTR_MAX == 0xffffffffffffffffu
+#define WASM_RT_MEMCHECK_SIGNAL_HANDLER_POSIX 1
+#else
+#error "Signal handler is not supported for this OS/Architecture!"
+#endif
+#else
+#define WASM_RT_MEMCHECK_SIGNAL_HANDLER_POSIX 0
+#endif
+
+/** Guard against stack exhaustion by comparing the native stack pointer with
+ * a per-thread limit instead of counting calls:
+ *
+ * #define WASM_RT_STACK_LIMIT 1
+ *
+ * `FUNC_PROLOGUE` then is a single compare against `wasm_rt_stack_limit`,
+ * `FUNC_EPILOGUE` is empty, and functions that call nothing else skip the
+ * check entirely. `WASM_RT_MAX_CALL_STACK_DEPTH` is ignored; the guest may
+ * use the thread's whole stack except for `WASM_RT_STACK_RESERVE` bytes, which
+ * are left for imports, libc and signal handlers.
+ *
+ * The same value must be used for the generated code and for wasm-rt-impl.c.
+ * */
+#ifndef WASM_RT_STACK_LIMIT
+#define WASM_RT_STACK_LIMIT 0
+#endif
+
+#ifndef WASM_RT_STACK_RESERVE
+#define WASM_RT_STACK_RESERVE (128 * 1024)
+#endif
+
+/** Keep this many bytes after the end of every linear memory accessible,
+ * although they are not part of it:
+ *
+ * #define WASM_RT_MEMORY_PADDING 8
+ *
+ * Generated code that masks addresses into a memory of fixed size can then
+ * let an access that starts at the last byte run past it without faulting.
+ * With reserved address space the padding follows the maximum size of the
+ * memory, so it is only adjacent to the memory once it is fully grown.
+ *
+ * The same value must be used for the generated code and for wasm-rt-impl.c.
+ * */
+#ifndef WASM_RT_MEMORY_PADDING
+#define WASM_RT_MEMORY_PADDING 0
+#endif
+
+/** Runtime state that is tied to the executing call stack (call depth, trap
+ * jump buffer) is thread-local, so different threads can run different
+ * instances at the same time. */
+#if defined(__cplusplus)
+#define WASM_RT_THREAD_LOCAL thread_local
+#else
+#define WASM_RT_THREAD_LOCAL _Thread_local
+#endif
+
+/** Reason a trap occurred. Provide this to `wasm_rt_trap`. */
+typedef enum {
+  WASM_RT_TRAP_NONE,               /** No error. */
+  WASM_RT_TRAP_OOB,                /** Out-of-bounds access in linear memory. */
+  WASM_RT_TRAP_INT_OVERFLOW,       /** Integer overflow on divide or truncation. */
+  WASM_RT_TRAP_DIV_BY_ZERO,        /** Integer divide by zero. */
+  WASM_RT_TRAP_INVALID_CONVERSION, /** Conversion from NaN to integer. */
+  WASM_RT_TRAP_UNREACHABLE,        /** Unreachable instruction executed. */
+  WASM_RT_TRAP_CALL_INDIRECT,      /** Invalid call_indirect, for any reason. */
+  WASM_RT_TRAP_EXHAUSTION,         /** Call stack exhausted. */
+  WASM_RT_TRAP_INTERRUPT,          /** Epoch deadline reached. */
+} wasm_rt_trap_t;
+
+/** Value types. Used to define function signatures. */
+typedef enum {
+  WASM_RT_I32,
+  WASM_RT_I64,
+  WASM_RT_F32,
+  WASM_RT_F64,
+} wasm_rt_type_t;
+
+/** A function type for all `anyfunc` functions in a Table. All functions are
+ * stored in this canonical form, but must be cast to their proper signature to
+ * call. */
+typedef void (*wasm_rt_anyfunc_t)(void);
+
+/** A single element of a Table. */
+typedef struct {
+  /** The index as returned from `wasm_rt_register_func_type`. */
+  uint32_t func_type;
+  /** The function. The embedder must know the actual C signature of the
+   * function and cast to it before calling. */
+  wasm_rt_anyfunc_t func;
+} wasm_rt_elem_t;
+
+/** A Memory object. */
+typedef struct {
+  /** The linear memory data, with a byte length of `size`. */
+  uint8_t* data;
+  /** The current and maximum page count for this Memory object. If there is no
+   * maximum, `max_pages` is 0xffffffffu (i.e. UINT32_MAX). */
+  uint32_t pages, max_pages;
+  /** The current size of the linear memory, in bytes. */
+  uint32_t size;
+  /** How many bytes at the start are backed by hugetlb pages (see
+   * `WASM_RT_HUGE_PAGES_EXPLICIT`); 0 if the pool could not provide them. */
+  uint32_t hugetlb_size;
+} wasm_rt_memory_t;
+
+/** A frozen copy of a Memory object's contents. On Linux the image lives in a
+ * memfd; memories created from it map the image copy-on-write, so untouched
+ * pages are shared between all of them and resetting a memory only has to
+ * throw away the pages it dirtied. */
+typedef struct {
+  /** memfd holding the image, or -1 if the image is only kept in `data`. */
+  int fd;
+  /** Read-only view of the image, `size` bytes long. */
+  const uint8_t* data;
+  /** Page count and byte length of the memory when it was frozen. */
+  uint32_t pages;
+  uint32_t size;
+} wasm_rt_memory_snapshot_t;
+
+/** A Table object. */
+typedef struct {
+  /** The table element data, with an element count of `size`. */
+  wasm_rt_elem_t* data;
+  /** The maximum element count of this Table object. If there is no maximum,
+   * `max_size` is 0xffffffffu (i.e. UINT32_MAX). */
+  uint32_t max_size;
+  /** The current element count of the table. */
+  uint32_t size;
+} wasm_rt_table_t;
+
+/** Stop execution immediately and jump back to the call to `wasm_rt_impl_try`.
+ *  The result of `wasm_rt_impl_try` will be the provided trap reason.
+ *
+ *  This is typically called by the generated code, and not the embedder. */
+extern void wasm_rt_trap(wasm_rt_trap_t) __attribute__((noreturn));
+
+/** Where the most recent trap on a thread came from. */
+typedef struct {
+  wasm_rt_trap_t code;
+  /** Code address in the trapping function: the faulting instruction for
+   * guard-page traps, the caller of `wasm_rt_trap` otherwise. Feed it to
+   * addr2line to get the function. */
+  const void* pc;
+  /** Faulting data address for guard-page traps, NULL otherwise. */
+  const void* fault_addr;
+} wasm_rt_trap_info_t;
+
+/** Filled in by every trap before it unwinds, on the trapping thread. */
+extern WASM_RT_THREAD_LOCAL wasm_rt_trap_info_t wasm_rt_last_trap;
+
+/** Number of traps with reason `code` so far, over all threads. */
+extern uint64_t wasm_rt_trap_count(wasm_rt_trap_t code);
+
+/** Function types with at most `WASM_RT_CANONICAL_FUNC_TYPE_MAX` params and
+ * results in total, of which at most `WASM_RT_CANONICAL_FUNC_TYPE_MAX_RESULTS`
+ * are results, have a canonical ID that needs no registration: bit 31 set,
+ * the result count in bits 28-30, the param count in bits 24-27, and the
+ * `wasm_rt_type_t` of each param and then each result in two bits each,
+ * starting at bit 0. Generated code emits these IDs as constants, so
+ * `CALL_INDIRECT` compares against an immediate. All other types get a
+ * registered ID below bit 31. */
+#define WASM_RT_CANONICAL_FUNC_TYPE_BIT 0x80000000u
+#define WASM_RT_CANONICAL_FUNC_TYPE_MAX 12
+#define WASM_RT_CANONICAL_FUNC_TYPE_MAX_RESULTS 7
+
+/** Register a function type with the given signature. The returned function
+ * index is guaranteed to be the same for all calls with the same signature.
+ * For signatures that have a canonical ID (see above) that ID is returned
+ * without registering anything; all other IDs are below 2^31.
+ * Safe to call from several threads.
+ * The following varargs must all be of type `wasm_rt_type_t`, first the
+ * params` and then the `results`.
+ *
+ *  ```
+ *    // Register (func (param i32 f32) (result i64)).
+ *    wasm_rt_register_func_type(2, 1, WASM_RT_I32, WASM_RT_F32, WASM_RT_I64);
+ *    => returns 0x92000018
+ *
+ *    // Register (func (result i64)).
+ *    wasm_rt_register_func_type(0, 1, WASM_RT_I64);
+ *    => returns 0x90000001
+ *
+ *    // Register (func (param i32 f32) (result i64)) again.
+ *    wasm_rt_register_func_type(2, 1, WASM_RT_I32, WASM_RT_F32, WASM_RT_I64);
+ *    => returns 0x92000018
+ *  ``` */
+extern uint32_t wasm_rt_register_func_type(uint32_t params,
+                                           uint32_t results,
+                                           ...);
+
+/** How linear memories are backed by the OS. */
+typedef enum {
+  /** Regular 4KiB pages. */
+  WASM_RT_HUGE_PAGES_NONE,
+  /** Align memories to 2MiB and ask for transparent huge pages
+   * (MADV_HUGEPAGE). */
+  WASM_RT_HUGE_PAGES_TRANSPARENT,
+  /** Map the initial 2MiB-aligned part of each memory from the hugetlb pool
+   * (MAP_HUGETLB). Falls back to transparent huge pages when the pool is
+   * empty or unsupported. */
+  WASM_RT_HUGE_PAGES_EXPLICIT,
+} wasm_rt_huge_pages_t;
+
+/** Huge pages are only used for memories that start at least this large. */
+#define WASM_RT_HUGE_PAGE_SIZE (2u * 1024 * 1024)
+
+/** Select the backing of memories allocated from now on. Call before
+ * allocating memories on other threads. Has no effect on platforms without
+ * huge page support, where every mode behaves like
+ * `WASM_RT_HUGE_PAGES_NONE`. */
+extern void wasm_rt_set_huge_pages(wasm_rt_huge_pages_t mode);
+
+/** Initialize a Memory object with an initial page size of `initial_pages` and
+ * a maximum page size of `max_pages`.
+ *
+ *  ```
+ *    wasm_rt_memory_t my_memory;
+ *    // 1 initial page (65536 bytes), and a maximum of 2 pages.
+ *    wasm_rt_allocate_memory(&my_memory, 1, 2);
+ *  ``` */
+extern void wasm_rt_allocate_memory(wasm_rt_memory_t*,
+                                    uint32_t initial_pages,
+                                    uint32_t max_pages);
+
+/** Release the data of a Memory object allocated by `wasm_rt_allocate_memory`.
+ */
+extern void wasm_rt_free_memory(wasm_rt_memory_t*);
+
+/** Freeze the current contents of `memory` into `snapshot`. The memory itself
+ * is left untouched and may keep running. */
+extern void wasm_rt_snapshot_memory(wasm_rt_memory_snapshot_t* snapshot,
+                                    const wasm_rt_memory_t* memory);
+
+/** One data segment of a module: `size` bytes at `data`, to be placed at
+ * `offset` in linear memory. */
+typedef struct {
+  uint32_t offset;
+  uint32_t size;
+  const uint8_t* data;
+} wasm_rt_data_segment_t;
+
+/** Lay out `segments` in a zeroed image of whole pages, frozen like a
+ * snapshot. Build it once per process, then load it into each new memory with
+ * `wasm_rt_map_memory_image`. */
+extern void wasm_rt_create_memory_image(wasm_rt_memory_snapshot_t* image,
+                                        const wasm_rt_data_segment_t* segments,
+                                        uint32_t segment_count);
+
+/** Replace the start of a freshly allocated `memory` with `image`. Where the
+ * image lives in a memfd it is mapped copy-on-write, so all memories share
+ * the pages that are never written. Traps if `memory` is smaller than the
+ * image. */
+extern void wasm_rt_map_memory_image(wasm_rt_memory_t*,
+                                     const wasm_rt_memory_snapshot_t* image);
+
+/** Release an image created by `wasm_rt_snapshot_memory` or
+ * `wasm_rt_create_memory_image`. Memories created from it stay valid. */
+extern void wasm_rt_free_memory_snapshot(wasm_rt_memory_snapshot_t*);
+
+/** Initialize a Memory object whose contents are a copy of `snapshot`, with a
+ * maximum page size of `max_pages`. Release it with `wasm_rt_free_memory`. */
+extern void wasm_rt_allocate_memory_from_snapshot(
+    wasm_rt_memory_t*,
+    const wasm_rt_memory_snapshot_t* snapshot,
+    uint32_t max_pages);
+
+/** Return a Memory object created by `wasm_rt_allocate_memory_from_snapshot`
+ * to the contents and size of `snapshot`, shrinking it if it has grown. */
+extern void wasm_rt_reset_memory(wasm_rt_memory_t*,
+                                 const wasm_rt_memory_snapshot_t* snapshot);
+
+/** Let the OS reclaim the physical pages that lie entirely within
+ * [offset, offset + size) of `memory`, e.g. the dead part of the guest stack
+ * between calls. The range stays accessible; it reads as zero afterwards, or
+ * as the snapshot contents for memories created from a snapshot. Returns the
+ * number of bytes released, 0 where this is not supported. */
+extern uint32_t wasm_rt_discard_memory(wasm_rt_memory_t*,
+                                       uint32_t offset,
+                                       uint32_t size);
+
+/** Prefer NUMA node `node` for every page of `memory` that is allocated from
+ * now on, including pages committed by later growth; best called before the
+ * memory is first written. Returns 0 on success, -1 where this is not
+ * supported. */
+extern int wasm_rt_bind_memory_to_node(wasm_rt_memory_t*, int node);
+
+/** Grow a Memory object by `pages`, and return the previous page count. If
+ * this new page count is greater than the maximum page count, or than 65535
+ * (the largest whose byte length fits `size`), the grow fails and 0xffffffffu
+ * (UINT32_MAX) is returned instead.
+ *
+ *  ```
+ *    wasm_rt_memory_t my_memory;
+ *    ...
+ *    // Grow memory by 10 pages.
+ *    uint32_t old_page_size = wasm_rt_grow_memory(&my_memory, 10);
+ *    if (old_page_size == UINT32_MAX) {
+ *      // Failed to grow memory.
+ *    }
+ *  ``` */
+extern uint32_t wasm_rt_grow_memory(wasm_rt_memory_t*, uint32_t pages);
+
+/** Initialize a Table object with an element count of `elements` and a maximum
+ * page size of `max_elements`.
+ *
+ *  ```
+ *    wasm_rt_table_t my_table;
+ *    // 5 elements and a maximum of 10 elements.
+ *    wasm_rt_allocate_table(&my_table, 5, 10);
+ *  ``` */
+extern void wasm_rt_allocate_table(wasm_rt_table_t*,
+                                   uint32_t elements,
+                                   uint32_t max_elements);
+
+/** Release the data of a Table object allocated by `wasm_rt_allocate_table`. */
+extern void wasm_rt_free_table(wasm_rt_table_t*);
+
+/** Current call stack depth of the calling thread. */
+extern WASM_RT_THREAD_LOCAL uint32_t wasm_rt_call_stack_depth;
+
+#if WASM_RT_STACK_LIMIT
+/** Lowest native stack address the guest may use on the calling thread.
+ * Starts out as UINTPTR_MAX so the first check on a thread takes the slow path
+ * in `wasm_rt_check_stack`, which computes the real limit. */
+extern WASM_RT_THREAD_LOCAL uintptr_t wasm_rt_stack_limit;
+
+/** Called by `FUNC_PROLOGUE` when the stack pointer is below
+ * `wasm_rt_stack_limit`. Traps with `WASM_RT_TRAP_EXHAUSTION` unless the limit
+ * was simply not initialized yet on this thread. */
+extern void wasm_rt_check_stack(void);
+#endif
+
+/** Process-wide epoch for interrupting guest code. Code generated with epoch
+ * checks compares it against a per-instance deadline at loop headers and
+ * function entries, so bumping it (e.g. from a timer thread) bounds how long
+ * any guest call runs without adding work to straight-line code. */
+extern uint64_t wasm_rt_epoch;
+
+/** Advance `wasm_rt_epoch` by one. Safe to call from any thread. */
+extern void wasm_rt_increment_epoch(void);
+
+/** Decides what happens when guest code on the calling thread reaches its
+ * deadline: return how many more epochs it may run for, e.g. after yielding
+ * the CPU, or 0 to trap with `WASM_RT_TRAP_INTERRUPT`. */
+typedef uint64_t (*wasm_rt_epoch_handler_t)(void* user_data);
+
+/** Set the epoch handler of the calling thread. The default (NULL) traps. */
+extern void wasm_rt_set_epoch_handler(wasm_rt_epoch_handler_t handler,
+                                      void* user_data);
+
+/** Called by generated code once `wasm_rt_epoch` has reached `*deadline`.
+ * Moves `*deadline` forward as the handler asks, or traps. */
+extern void wasm_rt_epoch_deadline_reached(uint64_t* deadline);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WASM_RT_H_ */